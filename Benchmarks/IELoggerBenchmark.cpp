@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IECore.h"
+
+// Log output goes to stdout and results go to stderr, run as `IELoggerBenchmark > /dev/null`
+// to compare the producer side cost without terminal rendering skewing the numbers.
+
+static constexpr uint32_t IterationCount = 100000;
+static constexpr uint32_t ThreadCount = 4;
+
+static void ReportLatencies(const char* Label, std::vector<int64_t>& Latencies)
+{
+    std::sort(Latencies.begin(), Latencies.end());
+    auto Percentile = [&Latencies](double Fraction)
+        {
+            return Latencies[static_cast<size_t>(Fraction * static_cast<double>(Latencies.size() - 1))];
+        };
+
+    int64_t TotalNs = 0;
+    for (const int64_t Latency : Latencies)
+    {
+        TotalNs += Latency;
+    }
+
+    std::fprintf(stderr, "%-24s mean %7.0f ns | p50 %7lld ns | p99 %8lld ns | max %9lld ns\n", Label,
+        static_cast<double>(TotalNs) / static_cast<double>(Latencies.size()),
+        static_cast<long long>(Percentile(0.50)), static_cast<long long>(Percentile(0.99)), static_cast<long long>(Latencies.back()));
+}
+
+static void RunLoggingThreads(const char* Label)
+{
+    std::vector<std::vector<int64_t>> ThreadLatencies(ThreadCount);
+    std::vector<std::thread> Threads;
+    for (uint32_t ThreadIndex = 0; ThreadIndex < ThreadCount; ThreadIndex++)
+    {
+        Threads.emplace_back([ThreadIndex, &ThreadLatencies]()
+            {
+                std::vector<int64_t>& Latencies = ThreadLatencies[ThreadIndex];
+                Latencies.reserve(IterationCount / ThreadCount);
+                for (uint32_t i = 0; i < IterationCount / ThreadCount; i++)
+                {
+                    const IEClock::time_point StartTime = IEClock::now();
+                    IELOG_INFO("Benchmark record %u from thread %u with value %f", i, ThreadIndex, i * 0.5);
+                    Latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(IEClock::now() - StartTime).count());
+                }
+            });
+    }
+
+    for (std::thread& Thread : Threads)
+    {
+        Thread.join();
+    }
+
+    std::vector<int64_t> Latencies;
+    for (const std::vector<int64_t>& ThreadLatency : ThreadLatencies)
+    {
+        Latencies.insert(Latencies.end(), ThreadLatency.begin(), ThreadLatency.end());
+    }
+    ReportLatencies(Label, Latencies);
+}
+
+int main()
+{
+    RunLoggingThreads("Synchronous");
+
+    IELogger::AsyncConfig DropConfig;
+    DropConfig.Capacity = 8192;
+    DropConfig.Overflow = IELogger::OverflowPolicy::Drop;
+    if (IELogger::StartAsync(DropConfig).Type == IEResult::Type::Success)
+    {
+        RunLoggingThreads("Asynchronous (Drop)");
+        IELogger::StopAsync();
+        std::fprintf(stderr, "%-24s %llu records dropped\n", "", static_cast<unsigned long long>(IELogger::GetDroppedRecordCount()));
+    }
+
+    IELogger::AsyncConfig BlockConfig;
+    BlockConfig.Capacity = 8192;
+    BlockConfig.Overflow = IELogger::OverflowPolicy::Block;
+    if (IELogger::StartAsync(BlockConfig).Type == IEResult::Type::Success)
+    {
+        RunLoggingThreads("Asynchronous (Block)");
+        IELogger::StopAsync();
+    }
+
+    const std::filesystem::path BinaryLogPath = std::filesystem::temp_directory_path() / "IELoggerBenchmark.ielog";
+    if (IELogger::StartBinary(BinaryLogPath).Type == IEResult::Type::Success)
+    {
+        RunLoggingThreads("Binary");
+        if (IELogger::StartAsync(BlockConfig).Type == IEResult::Type::Success)
+        {
+            RunLoggingThreads("Binary Asynchronous");
+            IELogger::StopAsync();
+        }
+        IELogger::StopBinary();
+        std::fprintf(stderr, "%-24s %llu bytes for %u records\n", "", static_cast<unsigned long long>(std::filesystem::file_size(BinaryLogPath)), IterationCount * 2);
+        std::filesystem::remove(BinaryLogPath);
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IECore.h"
+
+// Compares the previous std::string based IEResult against the current one. The legacy success test logs,
+// run as `IEResultBenchmark > /dev/null` so only the producer side cost of that log is measured.
+
+static constexpr uint32_t IterationCount = 1000000;
+
+using IEResultType = enum IEResult::Type;
+
+// Copy of the IEResult layout before messages became IEResultMessage
+struct IEResultLegacy
+{
+public:
+    IEResultLegacy(const IEResultType& _Type, const std::string _Message = std::string(), const std::source_location& CallerContext = std::source_location::current())
+        : Type(_Type), Message(_Message), CallerContextFuncName(CallerContext.function_name())
+    {}
+
+    operator bool() const
+    {
+        if (static_cast<int16_t>(Type) <= 0)
+        {
+            Private::IELog(-1, CallerContextFuncName, Message.c_str());
+            abort();
+        }
+        else if (static_cast<int16_t>(Type) > 1)
+        {
+            Private::IELog(2, CallerContextFuncName, Message.c_str());
+            return false;
+        }
+        Private::IELog(1, CallerContextFuncName, Message.c_str());
+        return true;
+    }
+
+public:
+    IEResultType Type = IEResultType::Unknown;
+    std::string Message = {};
+
+private:
+    const char* CallerContextFuncName = nullptr;
+};
+
+template<typename BenchmarkFunc>
+static void RunBenchmark(const char* Label, BenchmarkFunc&& Func)
+{
+    uint32_t SuccessCount = 0;
+    const IEClock::time_point StartTime = IEClock::now();
+    for (uint32_t i = 0; i < IterationCount; i++)
+    {
+        SuccessCount += Func(i) ? 1 : 0;
+    }
+    const int64_t TotalNs = std::chrono::duration_cast<std::chrono::nanoseconds>(IEClock::now() - StartTime).count();
+    std::fprintf(stderr, "%-40s %8.1f ns/op (%u successes)\n", Label, static_cast<double>(TotalNs) / IterationCount, SuccessCount);
+}
+
+// Keeps the compiler from folding the constructed results away
+template<typename ResultType>
+static ResultType Launder(const ResultType& Result)
+{
+    static volatile uint32_t Sink = 0;
+    Sink = Sink + 1;
+    return Result;
+}
+
+int main()
+{
+    IELogger::SetDeduplicationEnabled(false);
+
+    /* Construct */
+    RunBenchmark("Construct (legacy, long message)", [](uint32_t)
+        {
+            const IEResultLegacy Result(IEResult::Type::Success, "Successfully initialized ImGuiContext with Vulkan");
+            return Launder(Result).Type == IEResult::Type::Success;
+        });
+    RunBenchmark("Construct (static message)", [](uint32_t)
+        {
+            const IEResult Result(IEResult::Type::Success, "Successfully initialized ImGuiContext with Vulkan");
+            return Launder(Result).Type == IEResult::Type::Success;
+        });
+    RunBenchmark("Construct (formatted message)", [](uint32_t i)
+        {
+            const IEResult Result(IEResult::Type::Success, IEResultMessage::Format("Using physical device %s (%u)", "Benchmark Device", i));
+            return Launder(Result).Type == IEResult::Type::Success;
+        });
+
+    /* Copy */
+    const IEResultLegacy LegacyResult(IEResult::Type::Success, "Successfully initialized ImGuiContext with Vulkan");
+    RunBenchmark("Copy (legacy)", [&LegacyResult](uint32_t)
+        {
+            const IEResultLegacy Copy = Launder(LegacyResult);
+            return Copy.Type == IEResult::Type::Success;
+        });
+    const IEResult StaticResult(IEResult::Type::Success, "Successfully initialized ImGuiContext with Vulkan");
+    RunBenchmark("Copy (static message)", [&StaticResult](uint32_t)
+        {
+            const IEResult Copy = Launder(StaticResult);
+            return Copy.Type == IEResult::Type::Success;
+        });
+    const IEResult FormattedResult(IEResult::Type::Success, IEResultMessage::Format("Using physical device %s", "Benchmark Device"));
+    RunBenchmark("Copy (formatted message)", [&FormattedResult](uint32_t)
+        {
+            const IEResult Copy = Launder(FormattedResult);
+            return Copy.Type == IEResult::Type::Success;
+        });
+
+    /* Test */
+    RunBenchmark("Test success (legacy, logs)", [&LegacyResult](uint32_t)
+        {
+            return static_cast<bool>(Launder(LegacyResult));
+        });
+    RunBenchmark("Test success (quiet)", [&FormattedResult](uint32_t)
+        {
+            return static_cast<bool>(Launder(FormattedResult));
+        });
+    IEResult::SetSuccessLoggingEnabled(true);
+    RunBenchmark("Test success (success logging enabled)", [&FormattedResult](uint32_t)
+        {
+            return static_cast<bool>(Launder(FormattedResult));
+        });
+    IEResult::SetSuccessLoggingEnabled(false);
+
+    std::fprintf(stderr, "sizeof(IEResultLegacy) %zu, sizeof(IEResult) %zu\n", sizeof(IEResultLegacy), sizeof(IEResult));
+    return 0;
+}
@@ -4,14 +4,24 @@
 
 #include "IECore.h"
 
-class DemoApp
+class DemoApp : public IEApp
 {
-public:
-    DemoApp() : m_Renderer(std::make_unique<IERenderer_Vulkan>()) {}
-    IERenderer& GetRenderer() { return *m_Renderer; }
+protected:
+    IEResult OnInitialize() override
+    {
+        GetRenderer().SetDamageTrackingEnabled(true);
+        GetRenderer().SetBackgroundTrimEnabled(true);
+        return IEResult(IEResult::Type::Success);
+    }
+
+    void Update(double DeltaSeconds) override
+    {
+        // Fixed Timestep Simulation Code Goes Here
+        m_PreviousPhase = m_Phase;
+        m_Phase = std::fmod(m_Phase + DeltaSeconds * 0.25, 1.0);
+    }
 
-public:
-    void OnPreFrameRender()
+    void OnPreFrameRender(float Alpha) override
     {
         ImGui::ShowDemoWindow();
 
@@ -20,80 +30,63 @@ public:
         static std::string FilePath;
         ImGui::Text("Open File Finder: "); ImGui::SameLine();
         ImGui::FileFinder("File Finder", 3, FilePath);
+
+        bool bSimulationRunning = IsSimulationRunning();
+        if (ImGui::Checkbox("Run Simulation", &bSimulationRunning))
+        {
+            SetSimulationRunning(bSimulationRunning);
+        }
+
+        static constexpr const char* LatencyModeNames[] = { "Power Saving", "Balanced", "Low Latency", "Uncapped" };
+        int LatencyMode = static_cast<int>(GetRenderer().GetLatencyMode());
+        if (ImGui::Combo("Latency Mode", &LatencyMode, LatencyModeNames, IM_ARRAYSIZE(LatencyModeNames)))
+        {
+            GetRenderer().SetLatencyMode(static_cast<IELatencyMode>(LatencyMode));
+        }
+        // Interpolates between the last two updates, the wrap around is not blended
+        const double InterpolatedPhase = m_Phase >= m_PreviousPhase ? m_PreviousPhase + (m_Phase - m_PreviousPhase) * Alpha : m_Phase;
+        ImGui::ProgressBar(static_cast<float>(InterpolatedPhase));
         ImGui::End();
 
         //...
     }
 
-    void OnPostFrameRender()
+    void OnPostFrameRender() override
+    {
+        //...
+    }
+
+    void OnBackgroundTick() override
     {
+        // Runs about once per second while no UI frames are drawn
         //...
     }
 
 private:
-    std::unique_ptr<IERenderer> m_Renderer;
+    double m_Phase = 0.0;
+    double m_PreviousPhase = 0.0;
 };
 
 int main()
 {
-    DemoApp App;
-
-    IERenderer& Renderer = App.GetRenderer();
-    if (Renderer.Initialize(std::string("DemoApp"), true))
+    IEAppConfig Config;
+    Config.AppName = "DemoApp";
+    Config.bAllowRunInBackground = true;
+    Config.bRenderThreadEnabled = std::getenv("IE_RENDER_THREAD") != nullptr;
+    Config.bHostAllocatorEnabled = std::getenv("IE_HOST_ALLOCATOR") != nullptr;
+
+    // IE_INPUT_RECORD=<path> records the session, IE_INPUT_REPLAY=<path> replays one with a fixed delta time and exits
+    if (const char* const InputReplayPath = std::getenv("IE_INPUT_REPLAY"))
     {
-        if (ImGuiContext* const CreatedImGuiContext = ImGui::CreateContext())
-        {
-            ImGuiIO& IO = ImGui::GetIO();
-            IO.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard | ImGuiConfigFlags_IsSRGB;
-            if (Renderer.PostImGuiContextCreated())
-            {
-                ImGui::IEStyle::StyleIE();
-                IO.IniFilename = nullptr;
-                IO.LogFilename = nullptr;
-
-                IEClock::time_point StartFrameTime = IEClock::now();
-                IEDurationMs CapturedDeltaTime = IEDurationMs::zero();
-
-                while (Renderer.IsAppRunning())
-                {
-                    StartFrameTime = IEClock::now();
-
-                    Renderer.CheckAndResizeSwapChain();
-                    Renderer.NewFrame();
-                    ImGui::NewFrame();
-
-                    // On Pre Frame Render
-                    // Pre-Frame App Code Goes Here
-                    App.OnPreFrameRender();
-                    Renderer.DrawTelemetry();
-                    // On Pre Frame Render
-                    
-                    ImGui::Render();
-                    Renderer.RenderFrame(*ImGui::GetDrawData());
-                    Renderer.PresentFrame();
-
-                    // On Post Frame Render
-                    // Post-Frame App Code Goes Here
-                    App.OnPostFrameRender();
-                    // On Post Frame Render
-
-                    CapturedDeltaTime = std::chrono::duration_cast<IEDurationMs>(IEClock::now() - StartFrameTime);
-                    // Captured delta time can be used to enforce a fixed frame rate
-                    
-                    if (Renderer.IsAppWindowOpen())
-                    {
-                        Renderer.WaitEventsTimeout(0.1f);
-                    }
-                    else
-                    {
-                        Renderer.WaitEvents();
-                    }
-                }
-            }
-        }
-
-        Renderer.Deinitialize();
+        Config.InputReplayPath = InputReplayPath;
     }
+    else if (const char* const InputRecordPath = std::getenv("IE_INPUT_RECORD"))
+    {
+        Config.InputRecordPath = InputRecordPath;
+    }
+
+    DemoApp App;
+    App.Run(Config);
 
     return 0;
 }
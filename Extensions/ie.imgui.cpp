@@ -105,6 +105,7 @@ namespace ImGui
                         return;
                     }
 
+                    IE_PROFILE_SCOPE("FileFinder Directory Walk");
                     for (const std::filesystem::directory_entry& Entry : std::filesystem::directory_iterator(CurrentPath))
                     {
                         const std::filesystem::path& SubPath = Entry.path();
@@ -274,6 +275,7 @@ namespace ImGui
             const std::filesystem::path FontsDirectory = std::filesystem::path(IERESOURCES_DIR) / "Fonts";
             if (!FontsDirectory.empty() && std::filesystem::is_directory(FontsDirectory))
             {
+                IE_PROFILE_SCOPE("IEStyle Font Building");
                 ImFontConfig FontConfig;
                 FontConfig.OversampleH = 3;
                 FontConfig.OversampleV = 3;
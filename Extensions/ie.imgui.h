@@ -7,6 +7,7 @@
 #include "imgui.h"
 #include "imgui_internal.h"
 
+#include "Source/IEProfiler.h"
 #include "Source/IEUtils.h"
 
 namespace ImGui
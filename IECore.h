@@ -4,8 +4,17 @@
 
 #pragma once
 
+#include "Source/IEApp.h"
 #include "Source/IECommon.h"
+#include "Source/IEDrawDataSnapshot.h"
+#include "Source/IEFramePacer.h"
+#include "Source/IEFrameProfiler.h"
+#include "Source/IEInputLayer.h"
+#include "Source/IELogger.h"
+#include "Source/IEProfiler.h"
+#include "Source/IERefreshGovernor.h"
 #include "Source/IERenderer.h"
 #include "Source/IEUtils.h"
+#include "Source/IEVulkanHostAllocator.h"
 
 #include "Extensions/ie.imgui.h"
\ No newline at end of file
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEApp.h"
+
+#include "Extensions/ie.imgui.h"
+
+IEResult IEApp::Run(const IEAppConfig& Config)
+{
+    m_Config = Config;
+    m_Renderer->SetRenderThreadEnabled(m_Config.bRenderThreadEnabled);
+    m_Renderer->SetFramesInFlight(m_Config.FramesInFlight);
+    m_Renderer->SetLatencyMode(m_Config.LatencyMode);
+    m_Renderer->SetHostAllocatorEnabled(m_Config.bHostAllocatorEnabled);
+    IEResult Result = m_Renderer->Initialize(m_Config.AppName, m_Config.bAllowRunInBackground);
+    if (Result.Type == IEResult::Type::Success)
+    {
+        if (ImGui::CreateContext())
+        {
+            ImGuiIO& IO = ImGui::GetIO();
+            IO.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard | ImGuiConfigFlags_IsSRGB;
+            Result = m_Renderer->PostImGuiContextCreated();
+            if (Result.Type == IEResult::Type::Success)
+            {
+                ImGui::IEStyle::StyleIE();
+                IO.IniFilename = nullptr;
+                IO.LogFilename = nullptr;
+                m_Renderer->AddBackgroundTickCallbackFunc(m_Config.BackgroundTickInterval, [this]() { OnBackgroundTick(); });
+
+                Result = OnInitialize();
+                if (Result.Type == IEResult::Type::Success)
+                {
+                    RunLoop();
+                    OnShutdown();
+                }
+            }
+        }
+        else
+        {
+            Result = IEResult(IEResult::Type::Fail, "Failed to create ImGuiContext");
+        }
+
+        m_Renderer->Deinitialize();
+    }
+    return Result;
+}
+
+void IEApp::RunLoop()
+{
+    IERenderer& Renderer = *m_Renderer;
+
+    bool bExitAfterReplay = false;
+    if (!m_Config.InputReplayPath.empty())
+    {
+        bExitAfterReplay = Renderer.StartInputReplay(m_Config.InputReplayPath).Type == IEResult::Type::Success;
+    }
+    else if (!m_Config.InputRecordPath.empty())
+    {
+        Renderer.StartInputRecording(m_Config.InputRecordPath);
+    }
+
+    IEProfiler::SetCurrentThreadName("Main");
+    while (Renderer.IsAppRunning())
+    {
+        IE_PROFILE_SCOPE("Frame");
+
+        if (!Renderer.AdmitFrame())
+        {
+            // Closed to the background, minimized or hidden, the UI pipeline is skipped entirely
+            Renderer.WaitForBackgroundTick();
+            m_FramePacer.Reset();
+            m_LastUpdateClockTime.reset();
+            continue;
+        }
+
+        Renderer.CheckAndResizeSwapChain();
+        Renderer.NewFrame();
+
+        float Alpha = 0.0f;
+        {
+            IEFrameStageTimer UpdateTimer(Renderer.GetFrameProfiler(), IEFrameStage::Update);
+            Alpha = RunUpdates();
+        }
+
+        {
+            IEFrameStageTimer BuildUITimer(Renderer.GetFrameProfiler(), IEFrameStage::BuildUI);
+            ImGui::NewFrame();
+            OnPreFrameRender(Alpha);
+            if (m_Config.bDrawTelemetry)
+            {
+                Renderer.DrawTelemetry();
+            }
+        }
+
+        {
+            IEFrameStageTimer ImGuiRenderTimer(Renderer.GetFrameProfiler(), IEFrameStage::ImGuiRender);
+            ImGui::Render();
+        }
+
+        Renderer.RenderFrame(*ImGui::GetDrawData());
+        Renderer.PresentFrame();
+        OnPostFrameRender();
+
+        if (bExitAfterReplay && !Renderer.IsReplayingInput())
+        {
+            Renderer.RequestExit();
+        }
+
+        if (m_bSimulationRunning)
+        {
+            Renderer.RequestAnimationFor(m_Config.FixedTimestep * 2);
+        }
+
+        m_FramePacer.WaitForNextFrame();
+        if (Renderer.WaitForNextRedraw())
+        {
+            // Time spent idle is not simulated
+            m_FramePacer.Reset();
+            m_LastUpdateClockTime.reset();
+        }
+
+        // Follows the refresh governor, full display rate while interacting or animating
+        const IERefreshDecision& RefreshDecision = Renderer.GetRefreshDecision();
+        if (RefreshDecision.State == IERefreshState::Interactive || RefreshDecision.State == IERefreshState::Animating)
+        {
+            m_FramePacer.SetTargetFrameDuration(RefreshDecision.FrameDuration);
+        }
+    }
+}
+
+float IEApp::RunUpdates()
+{
+    const IEClock::time_point CurrentTime = IEClock::now();
+    const std::chrono::nanoseconds FixedTimestep = std::max(m_Config.FixedTimestep, std::chrono::nanoseconds(1));
+    if (m_LastUpdateClockTime.has_value())
+    {
+        m_UpdateAccumulator += std::chrono::duration_cast<std::chrono::nanoseconds>(CurrentTime - m_LastUpdateClockTime.value());
+    }
+    m_LastUpdateClockTime = CurrentTime;
+
+    const double DeltaSeconds = std::chrono::duration<double>(FixedTimestep).count();
+    uint32_t UpdateCount = 0;
+    while (m_UpdateAccumulator >= FixedTimestep && UpdateCount < m_Config.MaxUpdatesPerFrame)
+    {
+        Update(DeltaSeconds);
+        m_UpdateAccumulator -= FixedTimestep;
+        UpdateCount++;
+    }
+
+    if (m_UpdateAccumulator >= FixedTimestep)
+    {
+        IELOG_CATEGORY_WARNING_EVERY_MS(Frame, 1000, "Update fell behind, dropping %.2f ms of simulation time",
+            std::chrono::duration<double, std::milli>(m_UpdateAccumulator - m_UpdateAccumulator % FixedTimestep).count());
+        m_UpdateAccumulator %= FixedTimestep;
+    }
+    return static_cast<float>(static_cast<double>(m_UpdateAccumulator.count()) / static_cast<double>(FixedTimestep.count()));
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IEFramePacer.h"
+#include "IERenderer.h"
+
+struct IEAppConfig
+{
+    std::string AppName = "IEApp";
+    bool bAllowRunInBackground = false;
+    std::chrono::nanoseconds FixedTimestep = std::chrono::microseconds(16667);
+    // Catch-up limit, simulation time beyond this many updates per frame is dropped instead of spiraling
+    uint32_t MaxUpdatesPerFrame = 5;
+    std::chrono::nanoseconds BackgroundTickInterval = std::chrono::seconds(1);
+    bool bDrawTelemetry = true;
+    // See IERenderer::SetRenderThreadEnabled
+    bool bRenderThreadEnabled = false;
+    // See IERenderer::SetFramesInFlight
+    uint32_t FramesInFlight = 2;
+    // See IERenderer::SetLatencyMode
+    IELatencyMode LatencyMode = IELatencyMode::PowerSaving;
+    // See IERenderer::SetHostAllocatorEnabled
+    bool bHostAllocatorEnabled = false;
+    std::filesystem::path InputRecordPath;
+    std::filesystem::path InputReplayPath; // Exits once the replay finishes
+};
+
+// Owns the app loop: Update runs at a fixed timestep decoupled from the render rate, the UI stage then receives the
+// interpolation alpha between the last two updates. Frames are admitted, paced and scheduled through IERenderer.
+class IEApp
+{
+public:
+    IEApp() : m_Renderer(std::make_unique<IERenderer_Vulkan>()) {}
+    explicit IEApp(std::unique_ptr<IERenderer> Renderer) : m_Renderer(std::move(Renderer)) {}
+    virtual ~IEApp() = default;
+
+public:
+    // Initializes the renderer and ImGui, runs the loop until exit is requested and deinitializes.
+    IEResult Run(const IEAppConfig& Config = IEAppConfig());
+
+    IERenderer& GetRenderer() { return *m_Renderer; }
+    const IEAppConfig& GetConfig() const { return m_Config; }
+    // Keeps frames coming back to back so Update runs continuously, otherwise updates only run on drawn frames.
+    void SetSimulationRunning(bool bRunning) { m_bSimulationRunning = bRunning; }
+    bool IsSimulationRunning() const { return m_bSimulationRunning; }
+
+protected:
+    virtual IEResult OnInitialize() { return IEResult(IEResult::Type::Success); }
+    virtual void OnShutdown() {}
+    virtual void Update([[maybe_unused]] double DeltaSeconds) {}
+    // Alpha in [0, 1) is how far render time is past the last Update, for interpolating simulation state.
+    virtual void OnPreFrameRender([[maybe_unused]] float Alpha) {}
+    virtual void OnPostFrameRender() {}
+    virtual void OnBackgroundTick() {}
+
+private:
+    void RunLoop();
+    float RunUpdates();
+
+private:
+    std::unique_ptr<IERenderer> m_Renderer;
+    IEAppConfig m_Config;
+    IEFramePacer m_FramePacer;
+    std::optional<IEClock::time_point> m_LastUpdateClockTime;
+    std::chrono::nanoseconds m_UpdateAccumulator{};
+    bool m_bSimulationRunning = false;
+};
@@ -4,58 +4,47 @@
 
 #include "IECommon.h"
 
-/* Logging and Assertions */
+IEResultMessage::IEResultMessage(std::string _DynamicMessage)
+    : m_DynamicMessage(std::make_shared<const std::string>(std::move(_DynamicMessage)))
+{}
 
-namespace Private
+IEResultMessage::IEResultMessage(const IEResultMessage& OtherMessage)
+    : m_Format(OtherMessage.m_Format), m_PayloadSize(OtherMessage.m_PayloadSize), m_DynamicMessage(OtherMessage.m_DynamicMessage)
 {
-    static constexpr const char* ColorSpecifierReset = "\033[0m";
-    static constexpr const char* ColorSpecifierRed = "\033[31m";
-    static constexpr const char* ColorSpecifierGreen = "\033[32m";
-    static constexpr const char* ColorSpecifierYellow = "\033[33m";
-    void IELog(int LogLevel, const char* FuncName, const char* Format, ...)
+    std::memcpy(m_Payload, OtherMessage.m_Payload, m_PayloadSize);
+}
+
+IEResultMessage& IEResultMessage::operator=(const IEResultMessage& OtherMessage)
+{
+    if (this != &OtherMessage)
     {
-        const char* ColorCode = nullptr;
-        const char* LevelString = nullptr;
-        switch (LogLevel)
-        {
-            case -1:
-            {
-                ColorCode = ColorSpecifierRed;
-                LevelString = "Error";
-                break;
-            } 
-            case 0:
-            {
-               ColorCode = ColorSpecifierReset;
-                LevelString = "Log";
-                break; 
-            }
-            case 1:
-            {
-              ColorCode = ColorSpecifierGreen;
-                LevelString = "Success";
-                break;  
-            }
-            case 2:
-            {
-                ColorCode = ColorSpecifierYellow;
-                LevelString = "Warning";
-                break;
-            }
-            default:
-            {
-                break;
-            }
-        };
-        std::printf("%sIELog %s: ", ColorCode, LevelString);
-        va_list Args;
-        va_start(Args, Format);
-        std::vprintf(Format, Args);
-        va_end(Args);
-        std::printf(" [%s]%s\n", FuncName, ColorSpecifierReset);
+        m_Format = OtherMessage.m_Format;
+        m_PayloadSize = OtherMessage.m_PayloadSize;
+        std::memcpy(m_Payload, OtherMessage.m_Payload, m_PayloadSize);
+        m_DynamicMessage = OtherMessage.m_DynamicMessage;
     }
+    return *this;
 }
 
+std::string IEResultMessage::ToString() const
+{
+    return HasArguments() ? Private::FormatIELogPayload(m_Format, m_Payload, m_PayloadSize) : std::string(GetFormat());
+}
+
+#if ENABLE_IE_RESULT_LOGGING
+static void ReportIEResult(int LogLevel, const char* FuncName, const IEResultMessage& Message)
+{
+    if (Message.HasArguments())
+    {
+        Private::IELog(LogLevel, FuncName, "%s", Message.ToString().c_str());
+    }
+    else
+    {
+        Private::IELog(LogLevel, FuncName, "%s", Message.GetFormat());
+    }
+}
+#endif
+
 IEResult& IEResult::operator=(const IEResult& OtherResult)
 {
     if (this != &OtherResult)
@@ -81,22 +70,30 @@ IEResult::operator bool() const
     if (static_cast<int16_t>(Type) <= 0)
     {
 #if ENABLE_IE_RESULT_LOGGING
-        Private::IELog(-1, CallerContextFuncName, Message.c_str());
+        ReportIEResult(-1, CallerContextFuncName, Message);
 #endif
         abort();
     }
     else if (static_cast<int16_t>(Type) > 1)
     {
 #if ENABLE_IE_RESULT_LOGGING
-        Private::IELog(2, CallerContextFuncName, Message.c_str());
+        ReportIEResult(2, CallerContextFuncName, Message);
 #endif
         return false;
     }
     else // this->Type == IEResult::Type::Success
     {
 #if ENABLE_IE_RESULT_LOGGING
-        Private::IELog(1, CallerContextFuncName, Message.c_str());
+        if (bSuccessLoggingEnabled.load(std::memory_order_relaxed))
+        {
+            ReportIEResult(1, CallerContextFuncName, Message);
+        }
 #endif
         return true;
     }
 }
+
+void IEResult::SetSuccessLoggingEnabled(bool bEnabled)
+{
+    bSuccessLoggingEnabled.store(bEnabled, std::memory_order_relaxed);
+}
@@ -11,26 +11,38 @@
 #include <windows.h>
 #include <shlobj.h>
 #include <comdef.h> 
+#include <io.h>
 #elif defined(__APPLE__) || defined(__linux__)
+#include <fcntl.h>
 #include <pwd.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #endif
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
 #include <charconv>
 #include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <csignal>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <cwchar>
 #include <deque>
+#include <exception>
 #include <filesystem>
 #include <format>
 #include <functional>
+#include <future>
 #include <locale>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <queue>
 #include <set>
@@ -40,8 +52,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 #include <wchar.h>
 
@@ -60,16 +75,396 @@ static constexpr uint32_t TARGET_FRAME_DURATION = 1000 / 15;
     #define IEAssert(Expression) (Expression)
 #endif
 
+struct IELogSite
+{
+public:
+    // Every IELOG_* call site owns one constexpr IELogSite, its ID is derived at compile time from the
+    // format string, the enclosing function and the line so binary logs only carry the ID and raw arguments.
+    constexpr IELogSite(int _LogLevel, const char* _Format, const std::source_location& Location = std::source_location::current())
+        : LogLevel(_LogLevel), Format(_Format), FuncName(Location.function_name()), ID(HashSite(_Format, Location.function_name(), Location.line()))
+    {}
+
+public:
+    int LogLevel = 0;
+    const char* Format = nullptr;
+    const char* FuncName = nullptr;
+    uint32_t ID = 0;
+
+private:
+    static constexpr uint32_t HashSite(const char* Format, const char* FuncName, uint32_t Line)
+    {
+        uint32_t Hash = 2166136261u;
+        for (const char* Character = Format; Character && *Character; Character++)
+        {
+            Hash = (Hash ^ static_cast<uint8_t>(*Character)) * 16777619u;
+        }
+        for (const char* Character = FuncName; Character && *Character; Character++)
+        {
+            Hash = (Hash ^ static_cast<uint8_t>(*Character)) * 16777619u;
+        }
+        return (Hash ^ Line) * 16777619u;
+    }
+};
+
 namespace Private
 {
     void IELog(int LogLevel, const char* FuncName, const char* Format, ...);
+    void IELogBinary(const IELogSite& Site, const char* Payload, uint32_t PayloadSize);
+    std::string FormatIELogPayload(const char* Format, const char* Payload, uint32_t PayloadSize);
+    inline std::atomic<bool> bIELogBinaryEnabled = false;
+
+    /* Binary Log Argument Encoding */
+
+    static constexpr uint32_t IELogMaxPayloadSize = 256;
+
+    enum class IELogArgType : uint8_t
+    {
+        Int64 = 1,      // Zigzag varint
+        UInt64 = 2,     // Varint
+        Double = 3,     // 8 raw bytes
+        String = 4,     // Varint length followed by the bytes, truncated to fit the payload
+        Pointer = 5,    // Varint
+    };
+
+    class IELogArgEncoder
+    {
+    public:
+        IELogArgEncoder(char* _Buffer, uint32_t _Capacity) : Buffer(_Buffer), Capacity(_Capacity) {}
+
+        template<typename ArgType>
+        void Encode(const ArgType& Arg)
+        {
+            using DecayedArgType = std::decay_t<ArgType>;
+            if constexpr (std::is_same_v<DecayedArgType, char*> || std::is_same_v<DecayedArgType, const char*>)
+            {
+                const char* String = static_cast<const char*>(Arg);
+                if constexpr (!std::is_array_v<ArgType>)
+                {
+                    String = String ? String : "(null)";
+                }
+                const uint32_t Length = static_cast<uint32_t>(std::strlen(String));
+                if (WriteType(IELogArgType::String) && WriteVarint(Length))
+                {
+                    const uint32_t WrittenLength = std::min(Length, Capacity - Size);
+                    std::memcpy(Buffer + Size, String, WrittenLength);
+                    Size += WrittenLength;
+                }
+            }
+            else if constexpr (std::is_enum_v<DecayedArgType>)
+            {
+                Encode(static_cast<std::underlying_type_t<DecayedArgType>>(Arg));
+            }
+            else if constexpr (std::is_same_v<DecayedArgType, bool> || std::is_unsigned_v<DecayedArgType>)
+            {
+                if (WriteType(IELogArgType::UInt64))
+                {
+                    WriteVarint(static_cast<uint64_t>(Arg));
+                }
+            }
+            else if constexpr (std::is_integral_v<DecayedArgType>)
+            {
+                const int64_t Value = static_cast<int64_t>(Arg);
+                if (WriteType(IELogArgType::Int64))
+                {
+                    WriteVarint((static_cast<uint64_t>(Value) << 1) ^ static_cast<uint64_t>(Value >> 63));
+                }
+            }
+            else if constexpr (std::is_floating_point_v<DecayedArgType>)
+            {
+                const double Value = static_cast<double>(Arg);
+                if (WriteType(IELogArgType::Double) && Size + sizeof(Value) <= Capacity)
+                {
+                    std::memcpy(Buffer + Size, &Value, sizeof(Value));
+                    Size += sizeof(Value);
+                }
+            }
+            else if constexpr (std::is_pointer_v<DecayedArgType>)
+            {
+                if (WriteType(IELogArgType::Pointer))
+                {
+                    WriteVarint(reinterpret_cast<uintptr_t>(Arg));
+                }
+            }
+            else
+            {
+                static_assert(sizeof(ArgType) == -1, "IELOG argument type cannot be passed to a printf style format.");
+            }
+        }
+
+    public:
+        char* Buffer = nullptr;
+        uint32_t Capacity = 0;
+        uint32_t Size = 0;
+
+    private:
+        bool WriteType(IELogArgType Type)
+        {
+            if (Size < Capacity)
+            {
+                Buffer[Size++] = static_cast<char>(Type);
+                return true;
+            }
+            return false;
+        }
+
+        bool WriteVarint(uint64_t Value)
+        {
+            while (Size < Capacity)
+            {
+                const uint8_t Byte = static_cast<uint8_t>(Value & 0x7F);
+                Value >>= 7;
+                Buffer[Size++] = static_cast<char>(Value ? (Byte | 0x80) : Byte);
+                if (!Value)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    template<typename... ArgTypes>
+    void IELogAtSite(const IELogSite& Site, const ArgTypes&... Args)
+    {
+        if constexpr (sizeof...(ArgTypes) == 0)
+        {
+            if (bIELogBinaryEnabled.load(std::memory_order_relaxed))
+            {
+                IELogBinary(Site, nullptr, 0);
+            }
+            else
+            {
+                IELog(Site.LogLevel, Site.FuncName, Site.Format);
+            }
+        }
+        else if (bIELogBinaryEnabled.load(std::memory_order_relaxed))
+        {
+            char Payload[IELogMaxPayloadSize];
+            IELogArgEncoder Encoder(Payload, IELogMaxPayloadSize);
+            (Encoder.Encode(Args), ...);
+            IELogBinary(Site, Payload, Encoder.Size);
+        }
+        else
+        {
+            IELog(Site.LogLevel, Site.FuncName, Site.Format, Args...);
+        }
+    }
 }
-#define IELOG_ERROR(Format, ...)   Private::IELog(-1,  std::source_location::current().function_name(), Format, ##__VA_ARGS__)
-#define IELOG_INFO(Format, ...)    Private::IELog( 0,  std::source_location::current().function_name(), Format, ##__VA_ARGS__)
-#define IELOG_SUCCESS(Format, ...) Private::IELog( 1,  std::source_location::current().function_name(), Format, ##__VA_ARGS__)
-#define IELOG_WARNING(Format, ...) Private::IELog( 2,  std::source_location::current().function_name(), Format, ##__VA_ARGS__)
+
+/* Log Levels and Categories */
+
+enum class IELogLevel : int8_t
+{
+    Error = -1,
+    Info = 0,
+    Success = 1,
+    Warning = 2
+};
+
+// Global compile-time floor applied on top of every category, e.g. -DIELOG_COMPILE_TIME_MIN_LEVEL=IELogLevel::Warning
+#ifndef IELOG_COMPILE_TIME_MIN_LEVEL
+    #define IELOG_COMPILE_TIME_MIN_LEVEL IELogLevel::Info
+#endif
+
+namespace Private
+{
+    // Level values are kept for compatibility with Private::IELog, severity gives them an order to filter on.
+    constexpr int GetIELogSeverity(IELogLevel LogLevel)
+    {
+        switch (LogLevel)
+        {
+            case IELogLevel::Info: return 0;
+            case IELogLevel::Success: return 1;
+            case IELogLevel::Warning: return 2;
+            case IELogLevel::Error: return 3;
+        }
+        return 3;
+    }
+}
+
+// Declares a named category with a compile-time minimum level. Levels below it compile to nothing (arguments are
+// never evaluated), levels above it go through a single relaxed load against the category's runtime threshold.
+#define IELOG_DECLARE_CATEGORY(Category, CompileTimeMinLevel) \
+    struct IELogCategory_##Category \
+    { \
+        static constexpr const char* Name = #Category; \
+        static constexpr int CompileTimeMinSeverity = std::max(Private::GetIELogSeverity(CompileTimeMinLevel), Private::GetIELogSeverity(IELOG_COMPILE_TIME_MIN_LEVEL)); \
+        static inline std::atomic<int> RuntimeMinSeverity = CompileTimeMinSeverity; \
+        static bool IsEnabled(int Severity) { return Severity >= RuntimeMinSeverity.load(std::memory_order_relaxed); } \
+    }
+
+#define IELOG_SET_CATEGORY_LEVEL(Category, MinLevel) \
+    IELogCategory_##Category::RuntimeMinSeverity.store(std::max(Private::GetIELogSeverity(MinLevel), IELogCategory_##Category::CompileTimeMinSeverity), std::memory_order_relaxed)
+
+#if defined (NDEBUG)
+    #define IELOG_PER_FRAME_MIN_LEVEL IELogLevel::Warning
+#else
+    #define IELOG_PER_FRAME_MIN_LEVEL IELogLevel::Info
+#endif
+
+IELOG_DECLARE_CATEGORY(Core, IELogLevel::Info);
+IELOG_DECLARE_CATEGORY(Renderer, IELogLevel::Info);
+IELOG_DECLARE_CATEGORY(Frame, IELOG_PER_FRAME_MIN_LEVEL); // Code running every frame, info is compiled out of release builds
+
+namespace Private
+{
+    /* Per-site Rate Limiting */
+
+    // Site filters live in a function-local static next to their IELogSite, all state is a single atomic so the
+    // macros stay safe to call from any thread.
+    struct IELogAlways
+    {
+        constexpr bool ShouldLog() const { return true; }
+    };
+
+    class IELogOnce
+    {
+    public:
+        bool ShouldLog()
+        {
+            return !m_bLogged.load(std::memory_order_relaxed) && !m_bLogged.exchange(true, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<bool> m_bLogged = false;
+    };
+
+    class IELogEveryN
+    {
+    public:
+        constexpr explicit IELogEveryN(uint64_t N) : m_N(std::max<uint64_t>(N, 1)) {}
+
+        bool ShouldLog()
+        {
+            return m_Count.fetch_add(1, std::memory_order_relaxed) % m_N == 0;
+        }
+
+    private:
+        std::atomic<uint64_t> m_Count = 0;
+        uint64_t m_N = 1;
+    };
+
+    class IELogEveryMs
+    {
+    public:
+        constexpr explicit IELogEveryMs(int64_t WindowMs) : m_WindowNs(WindowMs * 1000000) {}
+
+        bool ShouldLog()
+        {
+            const int64_t NowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            int64_t NextAllowedNs = m_NextAllowedNs.load(std::memory_order_relaxed);
+            return NowNs >= NextAllowedNs && m_NextAllowedNs.compare_exchange_strong(NextAllowedNs, NowNs + m_WindowNs, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<int64_t> m_NextAllowedNs = 0;
+        int64_t m_WindowNs = 0;
+    };
+}
+
+#define IELOG_AT_FILTERED_SITE(Category, LogLevel, SiteFilter, Format, ...) \
+    do \
+    { \
+        if constexpr (Private::GetIELogSeverity(LogLevel) >= IELogCategory_##Category::CompileTimeMinSeverity) \
+        { \
+            static auto IELogSiteFilter = SiteFilter; \
+            if (IELogCategory_##Category::IsEnabled(Private::GetIELogSeverity(LogLevel)) && IELogSiteFilter.ShouldLog()) \
+            { \
+                static constexpr IELogSite IELogSiteInstance(static_cast<int>(LogLevel), Format); \
+                Private::IELogAtSite(IELogSiteInstance, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+#define IELOG_AT_SITE(Category, LogLevel, Format, ...) IELOG_AT_FILTERED_SITE(Category, LogLevel, Private::IELogAlways(), Format, ##__VA_ARGS__)
+
+#define IELOG_CATEGORY_ERROR(Category, Format, ...)   IELOG_AT_SITE(Category, IELogLevel::Error, Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_INFO(Category, Format, ...)    IELOG_AT_SITE(Category, IELogLevel::Info, Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_SUCCESS(Category, Format, ...) IELOG_AT_SITE(Category, IELogLevel::Success, Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_WARNING(Category, Format, ...) IELOG_AT_SITE(Category, IELogLevel::Warning, Format, ##__VA_ARGS__)
+
+#define IELOG_ERROR(Format, ...)   IELOG_CATEGORY_ERROR(Core, Format, ##__VA_ARGS__)
+#define IELOG_INFO(Format, ...)    IELOG_CATEGORY_INFO(Core, Format, ##__VA_ARGS__)
+#define IELOG_SUCCESS(Format, ...) IELOG_CATEGORY_SUCCESS(Core, Format, ##__VA_ARGS__)
+#define IELOG_WARNING(Format, ...) IELOG_CATEGORY_WARNING(Core, Format, ##__VA_ARGS__)
+
+// Logs only the first time the site is reached
+#define IELOG_CATEGORY_ERROR_ONCE(Category, Format, ...)   IELOG_AT_FILTERED_SITE(Category, IELogLevel::Error, Private::IELogOnce(), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_INFO_ONCE(Category, Format, ...)    IELOG_AT_FILTERED_SITE(Category, IELogLevel::Info, Private::IELogOnce(), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_SUCCESS_ONCE(Category, Format, ...) IELOG_AT_FILTERED_SITE(Category, IELogLevel::Success, Private::IELogOnce(), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_WARNING_ONCE(Category, Format, ...) IELOG_AT_FILTERED_SITE(Category, IELogLevel::Warning, Private::IELogOnce(), Format, ##__VA_ARGS__)
+#define IELOG_ERROR_ONCE(Format, ...)   IELOG_CATEGORY_ERROR_ONCE(Core, Format, ##__VA_ARGS__)
+#define IELOG_INFO_ONCE(Format, ...)    IELOG_CATEGORY_INFO_ONCE(Core, Format, ##__VA_ARGS__)
+#define IELOG_SUCCESS_ONCE(Format, ...) IELOG_CATEGORY_SUCCESS_ONCE(Core, Format, ##__VA_ARGS__)
+#define IELOG_WARNING_ONCE(Format, ...) IELOG_CATEGORY_WARNING_ONCE(Core, Format, ##__VA_ARGS__)
+
+// Logs the 1st, (N+1)th, (2N+1)th... time the site is reached
+#define IELOG_CATEGORY_ERROR_EVERY_N(Category, N, Format, ...)   IELOG_AT_FILTERED_SITE(Category, IELogLevel::Error, Private::IELogEveryN(N), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_INFO_EVERY_N(Category, N, Format, ...)    IELOG_AT_FILTERED_SITE(Category, IELogLevel::Info, Private::IELogEveryN(N), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_SUCCESS_EVERY_N(Category, N, Format, ...) IELOG_AT_FILTERED_SITE(Category, IELogLevel::Success, Private::IELogEveryN(N), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_WARNING_EVERY_N(Category, N, Format, ...) IELOG_AT_FILTERED_SITE(Category, IELogLevel::Warning, Private::IELogEveryN(N), Format, ##__VA_ARGS__)
+#define IELOG_ERROR_EVERY_N(N, Format, ...)   IELOG_CATEGORY_ERROR_EVERY_N(Core, N, Format, ##__VA_ARGS__)
+#define IELOG_INFO_EVERY_N(N, Format, ...)    IELOG_CATEGORY_INFO_EVERY_N(Core, N, Format, ##__VA_ARGS__)
+#define IELOG_SUCCESS_EVERY_N(N, Format, ...) IELOG_CATEGORY_SUCCESS_EVERY_N(Core, N, Format, ##__VA_ARGS__)
+#define IELOG_WARNING_EVERY_N(N, Format, ...) IELOG_CATEGORY_WARNING_EVERY_N(Core, N, Format, ##__VA_ARGS__)
+
+// Logs at most once per time window of WindowMs milliseconds
+#define IELOG_CATEGORY_ERROR_EVERY_MS(Category, WindowMs, Format, ...)   IELOG_AT_FILTERED_SITE(Category, IELogLevel::Error, Private::IELogEveryMs(WindowMs), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_INFO_EVERY_MS(Category, WindowMs, Format, ...)    IELOG_AT_FILTERED_SITE(Category, IELogLevel::Info, Private::IELogEveryMs(WindowMs), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_SUCCESS_EVERY_MS(Category, WindowMs, Format, ...) IELOG_AT_FILTERED_SITE(Category, IELogLevel::Success, Private::IELogEveryMs(WindowMs), Format, ##__VA_ARGS__)
+#define IELOG_CATEGORY_WARNING_EVERY_MS(Category, WindowMs, Format, ...) IELOG_AT_FILTERED_SITE(Category, IELogLevel::Warning, Private::IELogEveryMs(WindowMs), Format, ##__VA_ARGS__)
+#define IELOG_ERROR_EVERY_MS(WindowMs, Format, ...)   IELOG_CATEGORY_ERROR_EVERY_MS(Core, WindowMs, Format, ##__VA_ARGS__)
+#define IELOG_INFO_EVERY_MS(WindowMs, Format, ...)    IELOG_CATEGORY_INFO_EVERY_MS(Core, WindowMs, Format, ##__VA_ARGS__)
+#define IELOG_SUCCESS_EVERY_MS(WindowMs, Format, ...) IELOG_CATEGORY_SUCCESS_EVERY_MS(Core, WindowMs, Format, ##__VA_ARGS__)
+#define IELOG_WARNING_EVERY_MS(WindowMs, Format, ...) IELOG_CATEGORY_WARNING_EVERY_MS(Core, WindowMs, Format, ##__VA_ARGS__)
 
 #define ENABLE_IE_RESULT_LOGGING true
+
+// Either a static string, a printf style format with its arguments encoded inline, or a std::string.
+// Only the std::string form allocates, its text is shared between copies. Formatted text is only built by ToString(),
+// i.e. when the result is actually reported.
+class IEResultMessage
+{
+public:
+    static constexpr uint32_t MaxPayloadSize = 48;
+
+public:
+    constexpr IEResultMessage() = default;
+    // Only string literals are borrowed, any other text is copied since it could be gone before the result is reported
+    template<size_t N>
+    constexpr IEResultMessage(const char (&_StaticMessage)[N]) : m_Format(_StaticMessage) {}
+    template<size_t N>
+    IEResultMessage(char (&_DynamicMessage)[N]) : IEResultMessage(std::string(_DynamicMessage)) {}
+    template<typename CharPointerType> requires std::is_same_v<CharPointerType, const char*> || std::is_same_v<CharPointerType, char*>
+    IEResultMessage(CharPointerType _DynamicMessage) : IEResultMessage(std::string(_DynamicMessage ? _DynamicMessage : "")) {}
+    IEResultMessage(std::string _DynamicMessage);
+
+    IEResultMessage(const IEResultMessage& OtherMessage);
+    IEResultMessage& operator=(const IEResultMessage& OtherMessage);
+
+    // Format must be a string literal. Arguments follow the IELOG_* rules, strings are copied and truncated to fit MaxPayloadSize,
+    // longer text should be passed as a std::string.
+    template<size_t N, typename... ArgTypes>
+    static IEResultMessage Format(const char (&Format)[N], const ArgTypes&... Args)
+    {
+        IEResultMessage Message(Format);
+        Private::IELogArgEncoder Encoder(Message.m_Payload, MaxPayloadSize);
+        (Encoder.Encode(Args), ...);
+        Message.m_PayloadSize = Encoder.Size;
+        return Message;
+    }
+
+    std::string ToString() const;
+    operator std::string() const { return ToString(); }
+    const char* GetFormat() const { return m_DynamicMessage ? m_DynamicMessage->c_str() : m_Format ? m_Format : ""; }
+    bool HasArguments() const { return m_PayloadSize > 0; }
+
+private:
+    const char* m_Format = nullptr;
+    uint32_t m_PayloadSize = 0;
+    char m_Payload[MaxPayloadSize];
+    std::shared_ptr<const std::string> m_DynamicMessage;
+};
+
 struct IEResult
 {
 public:  
@@ -90,12 +485,12 @@ public:
     IEResult(IEResult&& other) = default;
 
 #if ENABLE_IE_RESULT_LOGGING
-    explicit IEResult(const IEResult::Type& _Type = Type::Unknown, const std::string _Message = std::string(), const std::source_location& CallerContext = std::source_location::current())
+    explicit IEResult(const IEResult::Type& _Type = Type::Unknown, const IEResultMessage& _Message = IEResultMessage(), const std::source_location& CallerContext = std::source_location::current())
         : Type(_Type), Message(_Message), CallerContextFuncName(CallerContext.function_name())
     {}
 #else
-    explicit IEResult(const IEResult::Type& _Type, const std::string _Message = std::string())
-        : Type(_Type)
+    explicit IEResult(const IEResult::Type& _Type, const IEResultMessage& _Message = IEResultMessage())
+        : Type(_Type), Message(_Message)
     {}
 #endif
 
@@ -104,10 +499,119 @@ public:
     bool operator!=(const IEResult& OtherResult) const;
     operator bool() const;
 
+    // Failures and warnings are always reported, successes stay quiet unless enabled here.
+    static void SetSuccessLoggingEnabled(bool bEnabled);
+
 public:
     Type Type = Type::Unknown;
-    std::string Message = {};
+    IEResultMessage Message = {};
 
 private:
     const char* CallerContextFuncName = nullptr;
-};
\ No newline at end of file
+    static inline std::atomic<bool> bSuccessLoggingEnabled = false;
+};
+
+template<typename T>
+class IEExpected;
+
+namespace Private
+{
+    template<typename T>
+    inline constexpr bool IsIEExpected = false;
+    template<typename T>
+    inline constexpr bool IsIEExpected<IEExpected<T>> = true;
+}
+
+// Either a value or the IEResult describing why there is none, in the spirit of std::expected.
+// Testing it never logs or aborts so recoverable failures can be branched on, the value lives inline (no heap).
+// A failed IEResult converts implicitly, e.g. `return IEResult(IEResult::Type::Fail, "...");`.
+template<typename T>
+class IEExpected
+{
+    static_assert(!std::is_void_v<T> && !std::is_reference_v<T>, "IEExpected requires an object type, return IEResult for void operations.");
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, IEResult>, "IEExpected<IEResult> is ambiguous, return IEResult directly.");
+
+public:
+    using ValueType = T;
+
+public:
+    IEExpected(const T& _Value) : m_Storage(std::in_place_index<0>, _Value) {}
+    IEExpected(T&& _Value) : m_Storage(std::in_place_index<0>, std::move(_Value)) {}
+    IEExpected(const IEResult& _Error) : m_Storage(std::in_place_index<1>, _Error)
+    {
+        assert(_Error.Type != IEResult::Type::Success);
+    }
+
+    bool HasValue() const { return m_Storage.index() == 0; }
+    explicit operator bool() const { return HasValue(); }
+
+    T& Value() & { assert(HasValue()); return *std::get_if<0>(&m_Storage); }
+    const T& Value() const& { assert(HasValue()); return *std::get_if<0>(&m_Storage); }
+    T&& Value() && { assert(HasValue()); return std::move(*std::get_if<0>(&m_Storage)); }
+
+    T& operator*() & { return Value(); }
+    const T& operator*() const& { return Value(); }
+    T* operator->() { return &Value(); }
+    const T* operator->() const { return &Value(); }
+
+    const IEResult& Error() const { assert(!HasValue()); return *std::get_if<1>(&m_Storage); }
+
+    template<typename DefaultType>
+    T ValueOr(DefaultType&& Default) const& { return HasValue() ? Value() : static_cast<T>(std::forward<DefaultType>(Default)); }
+
+    // Collapses back into an IEResult for APIs that only report success or failure.
+    IEResult ToResult(const IEResultMessage& SuccessMessage = IEResultMessage(), const std::source_location& CallerContext = std::source_location::current()) const
+    {
+        return HasValue() ? IEResult(IEResult::Type::Success, SuccessMessage, CallerContext) : Error();
+    }
+
+    /* Monadic Operations */
+
+    // Func(T) -> IEExpected<U>, skipped and the error forwarded when there is no value
+    template<typename FuncType>
+    auto and_then(FuncType&& Func) const&
+    {
+        using ResultType = std::remove_cvref_t<std::invoke_result_t<FuncType, const T&>>;
+        static_assert(Private::IsIEExpected<ResultType>, "and_then must return an IEExpected.");
+        return HasValue() ? std::invoke(std::forward<FuncType>(Func), Value()) : ResultType(Error());
+    }
+
+    template<typename FuncType>
+    auto and_then(FuncType&& Func) &&
+    {
+        using ResultType = std::remove_cvref_t<std::invoke_result_t<FuncType, T&&>>;
+        static_assert(Private::IsIEExpected<ResultType>, "and_then must return an IEExpected.");
+        return HasValue() ? std::invoke(std::forward<FuncType>(Func), std::move(*this).Value()) : ResultType(Error());
+    }
+
+    // Func(T) -> U, wrapped into IEExpected<U>
+    template<typename FuncType>
+    auto transform(FuncType&& Func) const&
+    {
+        using ResultType = IEExpected<std::remove_cvref_t<std::invoke_result_t<FuncType, const T&>>>;
+        return HasValue() ? ResultType(std::invoke(std::forward<FuncType>(Func), Value())) : ResultType(Error());
+    }
+
+    template<typename FuncType>
+    auto transform(FuncType&& Func) &&
+    {
+        using ResultType = IEExpected<std::remove_cvref_t<std::invoke_result_t<FuncType, T&&>>>;
+        return HasValue() ? ResultType(std::invoke(std::forward<FuncType>(Func), std::move(*this).Value())) : ResultType(Error());
+    }
+
+    // Func(const IEResult&) -> IEExpected<T>, lets a failure be recovered from or replaced
+    template<typename FuncType>
+    IEExpected or_else(FuncType&& Func) const&
+    {
+        return HasValue() ? *this : IEExpected(std::invoke(std::forward<FuncType>(Func), Error()));
+    }
+
+    template<typename FuncType>
+    IEExpected or_else(FuncType&& Func) &&
+    {
+        return HasValue() ? std::move(*this) : IEExpected(std::invoke(std::forward<FuncType>(Func), Error()));
+    }
+
+private:
+    std::variant<T, IEResult> m_Storage;
+};
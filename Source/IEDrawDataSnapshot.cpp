@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEDrawDataSnapshot.h"
+
+IEDrawDataSnapshot::~IEDrawDataSnapshot()
+{
+    for (ImDrawList* const DrawList : m_DrawListPool)
+    {
+        IM_DELETE(DrawList);
+    }
+}
+
+void IEDrawDataSnapshot::Capture(const ImDrawData& DrawData)
+{
+    m_DrawData.Clear();
+    m_CapturedBytes = 0;
+
+    while (m_DrawListPool.size() < static_cast<size_t>(DrawData.CmdListsCount))
+    {
+        m_DrawListPool.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+    }
+
+    for (int DrawListIndex = 0; DrawListIndex < DrawData.CmdListsCount; DrawListIndex++)
+    {
+        const ImDrawList* const SourceDrawList = DrawData.CmdLists[DrawListIndex];
+        ImDrawList* const DrawList = m_DrawListPool[DrawListIndex];
+        CopyBuffer(DrawList->CmdBuffer, SourceDrawList->CmdBuffer);
+        CopyBuffer(DrawList->IdxBuffer, SourceDrawList->IdxBuffer);
+        CopyBuffer(DrawList->VtxBuffer, SourceDrawList->VtxBuffer);
+        DrawList->Flags = SourceDrawList->Flags;
+        m_DrawData.CmdLists.push_back(DrawList);
+
+        m_CapturedBytes += SourceDrawList->CmdBuffer.size_in_bytes() + SourceDrawList->IdxBuffer.size_in_bytes() + SourceDrawList->VtxBuffer.size_in_bytes();
+    }
+
+    m_DrawData.Valid = DrawData.Valid;
+    m_DrawData.CmdListsCount = DrawData.CmdListsCount;
+    m_DrawData.TotalIdxCount = DrawData.TotalIdxCount;
+    m_DrawData.TotalVtxCount = DrawData.TotalVtxCount;
+    m_DrawData.DisplayPos = DrawData.DisplayPos;
+    m_DrawData.DisplaySize = DrawData.DisplaySize;
+    m_DrawData.FramebufferScale = DrawData.FramebufferScale;
+    m_DrawData.OwnerViewport = DrawData.OwnerViewport;
+}
+
+template<typename T>
+void IEDrawDataSnapshot::CopyBuffer(ImVector<T>& Destination, const ImVector<T>& Source)
+{
+    // ImVector::operator= frees the destination first, resize keeps the pooled capacity
+    Destination.resize(Source.Size);
+    if (Source.Size > 0)
+    {
+        std::memcpy(Destination.Data, Source.Data, Source.size_in_bytes());
+    }
+}
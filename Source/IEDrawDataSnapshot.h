@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "imgui.h"
+
+#include "IECommon.h"
+
+// Deep copy of an ImDrawData that stays valid while ImGui builds the next frame.
+// Draw lists and their command, index and vertex buffers are pooled and only ever grow,
+// so once the UI reached its steady state size a capture is a handful of memcpys and no allocations.
+// ImDrawCmd::UserCallback and TextureId are copied as is, they must stay valid until the snapshot is rendered.
+class IEDrawDataSnapshot
+{
+public:
+    IEDrawDataSnapshot() = default;
+    ~IEDrawDataSnapshot();
+
+    IEDrawDataSnapshot(const IEDrawDataSnapshot&) = delete;
+    IEDrawDataSnapshot& operator=(const IEDrawDataSnapshot&) = delete;
+
+public:
+    void Capture(const ImDrawData& DrawData);
+    ImDrawData& GetDrawData() { return m_DrawData; }
+    size_t GetCapturedBytes() const { return m_CapturedBytes; }
+
+private:
+    template<typename T>
+    static void CopyBuffer(ImVector<T>& Destination, const ImVector<T>& Source);
+
+private:
+    ImDrawData m_DrawData;
+    std::vector<ImDrawList*> m_DrawListPool;
+    size_t m_CapturedBytes = 0;
+};
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEFramePacer.h"
+
+static constexpr std::chrono::nanoseconds MinSpinThreshold = std::chrono::microseconds(200);
+static constexpr std::chrono::nanoseconds MaxSpinThreshold = std::chrono::milliseconds(4);
+
+IEFramePacer::IEFramePacer(std::chrono::nanoseconds _TargetFrameDuration)
+    : m_TargetFrameDuration(_TargetFrameDuration), m_SpinThreshold(std::chrono::milliseconds(1))
+{
+#if defined (_WIN32)
+    // High resolution waitable timers avoid the default 15.6ms scheduler tick without changing the global timer period
+    m_WaitableTimer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    m_SpinThreshold = std::chrono::milliseconds(m_WaitableTimer ? 1 : 2);
+#endif
+    m_Statistics.SpinThresholdUs = static_cast<float>(m_SpinThreshold.count()) / 1e3f;
+}
+
+IEFramePacer::~IEFramePacer()
+{
+#if defined (_WIN32)
+    if (m_WaitableTimer)
+    {
+        CloseHandle(m_WaitableTimer);
+    }
+#endif
+}
+
+void IEFramePacer::SetTargetFrameDuration(std::chrono::nanoseconds _TargetFrameDuration)
+{
+    if (m_TargetFrameDuration != _TargetFrameDuration)
+    {
+        m_TargetFrameDuration = _TargetFrameDuration;
+        Reset();
+    }
+}
+
+void IEFramePacer::SetTargetFrameRate(double FramesPerSecond)
+{
+    if (FramesPerSecond > 0.0)
+    {
+        SetTargetFrameDuration(std::chrono::nanoseconds(static_cast<int64_t>(1e9 / FramesPerSecond)));
+    }
+}
+
+void IEFramePacer::WaitForNextFrame()
+{
+    IEClock::time_point CurrentTime = IEClock::now();
+    if (!m_NextDeadline.has_value())
+    {
+        m_NextDeadline = CurrentTime + m_TargetFrameDuration;
+    }
+
+    const IEClock::time_point Deadline = m_NextDeadline.value();
+    if (CurrentTime >= Deadline)
+    {
+        // The frame overran, restart the cadence from now instead of bursting to catch up
+        m_Statistics.FrameCount++;
+        m_Statistics.MissedDeadlineCount++;
+        m_NextDeadline = CurrentTime + m_TargetFrameDuration;
+        return;
+    }
+
+    const std::chrono::nanoseconds SleepDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(Deadline - CurrentTime) - m_SpinThreshold;
+    if (SleepDuration > std::chrono::nanoseconds::zero())
+    {
+        const IEClock::time_point SleepDeadline = CurrentTime + SleepDuration;
+        SleepFor(SleepDuration);
+        CurrentTime = IEClock::now();
+
+        const double SleepOvershootNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(CurrentTime - SleepDeadline).count());
+        m_SleepOvershootEstimateNs = m_SleepOvershootEstimateNs == 0.0 ? SleepOvershootNs : m_SleepOvershootEstimateNs * 0.9 + SleepOvershootNs * 0.1;
+        m_SpinThreshold = std::clamp(std::chrono::nanoseconds(static_cast<int64_t>(m_SleepOvershootEstimateNs * 2.0)), MinSpinThreshold, MaxSpinThreshold);
+    }
+
+    while (CurrentTime < Deadline)
+    {
+        std::this_thread::yield();
+        CurrentTime = IEClock::now();
+    }
+
+    const float OvershootUs = std::chrono::duration<float, std::micro>(CurrentTime - Deadline).count();
+    m_Statistics.FrameCount++;
+    m_Statistics.LastOvershootUs = OvershootUs;
+    m_Statistics.MeanOvershootUs += (OvershootUs - m_Statistics.MeanOvershootUs) / static_cast<float>(m_Statistics.FrameCount - m_Statistics.MissedDeadlineCount);
+    m_Statistics.MaxOvershootUs = std::max(m_Statistics.MaxOvershootUs, OvershootUs);
+    m_Statistics.SpinThresholdUs = static_cast<float>(m_SpinThreshold.count()) / 1e3f;
+
+    m_NextDeadline = Deadline + m_TargetFrameDuration;
+}
+
+void IEFramePacer::Reset()
+{
+    m_NextDeadline.reset();
+}
+
+void IEFramePacer::SleepFor(std::chrono::nanoseconds Duration)
+{
+#if defined (_WIN32)
+    if (m_WaitableTimer)
+    {
+        LARGE_INTEGER DueTime;
+        DueTime.QuadPart = -static_cast<LONGLONG>(Duration.count() / 100); // Relative, in 100ns units
+        if (SetWaitableTimer(m_WaitableTimer, &DueTime, 0, nullptr, nullptr, FALSE))
+        {
+            WaitForSingleObject(m_WaitableTimer, INFINITE);
+            return;
+        }
+    }
+#endif
+    std::this_thread::sleep_for(Duration);
+}
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IECommon.h"
+
+// Holds the frame loop to a fixed cadence: sleeps coarsely until shortly before the deadline, then spins the last
+// stretch so wakeups land within ~100us. Targets longer than the display refresh interval save CPU and power.
+class IEFramePacer
+{
+public:
+    struct Statistics
+    {
+        uint64_t FrameCount = 0;
+        uint64_t MissedDeadlineCount = 0; // Frames whose work alone took longer than the target
+        float LastOvershootUs = 0.0f;
+        float MeanOvershootUs = 0.0f;
+        float MaxOvershootUs = 0.0f;
+        float SpinThresholdUs = 0.0f;
+    };
+
+public:
+    explicit IEFramePacer(std::chrono::nanoseconds _TargetFrameDuration = std::chrono::milliseconds(TARGET_FRAME_DURATION));
+    ~IEFramePacer();
+
+    IEFramePacer(const IEFramePacer&) = delete;
+    IEFramePacer& operator=(const IEFramePacer&) = delete;
+
+public:
+    void SetTargetFrameDuration(std::chrono::nanoseconds _TargetFrameDuration);
+    void SetTargetFrameRate(double FramesPerSecond);
+    std::chrono::nanoseconds GetTargetFrameDuration() const { return m_TargetFrameDuration; }
+
+    // Blocks until the current frame's deadline and schedules the next one target duration later.
+    // Deadlines advance from the previous deadline rather than the wakeup so error does not accumulate.
+    void WaitForNextFrame();
+    // Drops the deadline, e.g. after the loop blocked on events, so the next frame is not treated as late.
+    void Reset();
+
+    const Statistics& GetStatistics() const { return m_Statistics; }
+
+private:
+    void SleepFor(std::chrono::nanoseconds Duration);
+
+private:
+    std::chrono::nanoseconds m_TargetFrameDuration;
+    std::optional<IEClock::time_point> m_NextDeadline;
+    // Learned from how late coarse sleeps wake up, everything closer than this to the deadline is spun
+    std::chrono::nanoseconds m_SpinThreshold;
+    double m_SleepOvershootEstimateNs = 0.0;
+    Statistics m_Statistics;
+#if defined (_WIN32)
+    HANDLE m_WaitableTimer = nullptr;
+#endif
+};
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEFrameProfiler.h"
+
+const char* GetIEFrameStageName(IEFrameStage Stage)
+{
+    switch (Stage)
+    {
+    case IEFrameStage::CheckAndResizeSwapChain: return "Resize Check";
+    case IEFrameStage::NewFrame: return "New Frame";
+    case IEFrameStage::Update: return "Update";
+    case IEFrameStage::BuildUI: return "Build UI";
+    case IEFrameStage::ImGuiRender: return "ImGui Render";
+    case IEFrameStage::AcquireImage: return "Acquire Image";
+    case IEFrameStage::FenceWait: return "Fence Wait";
+    case IEFrameStage::RecordCommands: return "Record";
+    case IEFrameStage::Submit: return "Submit";
+    case IEFrameStage::PresentFrame: return "Present";
+    default: return "Unknown";
+    }
+}
+
+void IEFrameProfiler::AddStageDuration(IEFrameStage Stage, int64_t DurationNs)
+{
+    m_CurrentFrameNs[static_cast<uint32_t>(Stage)].fetch_add(DurationNs, std::memory_order_relaxed);
+}
+
+void IEFrameProfiler::EndFrame()
+{
+    int64_t TotalNs = 0;
+    for (uint32_t StageIndex = 0; StageIndex < StageCount; StageIndex++)
+    {
+        // With a render thread its stages land in whichever UI frame ends next
+        const int64_t StageNs = m_CurrentFrameNs[StageIndex].exchange(0, std::memory_order_relaxed);
+        m_StageHistoryMs[StageIndex][m_HistoryIndex] = static_cast<float>(StageNs) / 1e6f;
+        TotalNs += StageNs;
+    }
+    m_TotalHistoryMs[m_HistoryIndex] = static_cast<float>(TotalNs) / 1e6f;
+    m_GPUHistoryMs[m_HistoryIndex] = m_LastGPUFrameDurationMs.load(std::memory_order_relaxed);
+
+    m_HistoryIndex = (m_HistoryIndex + 1) % HistorySize;
+    m_HistoryCount = std::min(m_HistoryCount + 1, HistorySize);
+}
+
+void IEFrameProfiler::SetGPUFrameDuration(int64_t DurationNs)
+{
+    m_LastGPUFrameDurationMs.store(static_cast<float>(DurationNs) / 1e6f, std::memory_order_relaxed);
+    m_bHasGPUTimings.store(true, std::memory_order_relaxed);
+}
+
+IEFrameProfiler::StageStatistics IEFrameProfiler::ComputeStageStatistics(IEFrameStage Stage) const
+{
+    return ComputeStatistics(m_StageHistoryMs[static_cast<uint32_t>(Stage)], m_HistoryCount);
+}
+
+IEFrameProfiler::StageStatistics IEFrameProfiler::ComputeTotalStatistics() const
+{
+    return ComputeStatistics(m_TotalHistoryMs, m_HistoryCount);
+}
+
+IEFrameProfiler::StageStatistics IEFrameProfiler::ComputeGPUStatistics() const
+{
+    return ComputeStatistics(m_GPUHistoryMs, m_HistoryCount);
+}
+
+IEFrameProfiler::StageStatistics IEFrameProfiler::ComputeStatistics(const std::array<float, HistorySize>& History, uint32_t Count)
+{
+    StageStatistics Statistics;
+    if (Count > 0)
+    {
+        // Until the ring wraps the valid samples are [0, Count), afterwards every slot is valid
+        std::array<float, HistorySize> SortedHistory = History;
+        std::sort(SortedHistory.begin(), SortedHistory.begin() + Count);
+        auto Percentile = [&SortedHistory, Count](float Fraction)
+            {
+                return SortedHistory[static_cast<uint32_t>(Fraction * static_cast<float>(Count - 1) + 0.5f)];
+            };
+
+        Statistics.P50Ms = Percentile(0.50f);
+        Statistics.P95Ms = Percentile(0.95f);
+        Statistics.P99Ms = Percentile(0.99f);
+        Statistics.MaxMs = SortedHistory[Count - 1];
+    }
+    return Statistics;
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IECommon.h"
+#include "IEProfiler.h"
+
+#ifndef ENABLE_IE_FRAME_PROFILER
+#define ENABLE_IE_FRAME_PROFILER true
+#endif
+
+enum class IEFrameStage : uint8_t
+{
+    CheckAndResizeSwapChain,
+    NewFrame,
+    Update,
+    BuildUI,
+    ImGuiRender,
+    AcquireImage,
+    FenceWait,
+    RecordCommands,
+    Submit,
+    PresentFrame,
+    Count
+};
+
+const char* GetIEFrameStageName(IEFrameStage Stage);
+
+// Accumulates CPU time per frame stage and keeps the last HistorySize frames in a ring buffer.
+// Recording costs two clock reads per stage, percentiles are only computed when someone asks for them.
+// AddStageDuration and SetGPUFrameDuration may be called from the render thread, everything else belongs to the UI thread.
+class IEFrameProfiler
+{
+public:
+    static constexpr uint32_t HistorySize = 256;
+    static constexpr uint32_t StageCount = static_cast<uint32_t>(IEFrameStage::Count);
+
+    struct StageStatistics
+    {
+        float P50Ms = 0.0f;
+        float P95Ms = 0.0f;
+        float P99Ms = 0.0f;
+        float MaxMs = 0.0f;
+    };
+
+public:
+    void AddStageDuration(IEFrameStage Stage, int64_t DurationNs);
+    // Commits the accumulated stage durations as one frame, called once per frame by IERenderer::PresentFrame.
+    void EndFrame();
+
+    // Total is the sum of every stage, i.e. the CPU time of the frame excluding event waits.
+    StageStatistics ComputeStageStatistics(IEFrameStage Stage) const;
+    StageStatistics ComputeTotalStatistics() const;
+
+    // GPU time of a frame arrives a few frames late (once its slot is reused), it is stored with the frame that reads it.
+    void SetGPUFrameDuration(int64_t DurationNs);
+    StageStatistics ComputeGPUStatistics() const;
+    bool HasGPUTimings() const { return m_bHasGPUTimings.load(std::memory_order_relaxed); }
+    float GetLastGPUFrameDurationMs() const { return m_LastGPUFrameDurationMs.load(std::memory_order_relaxed); }
+
+    // Chronological history for ImGui::PlotLines, pass GetHistoryOffset() as values_offset.
+    const float* GetStageHistory(IEFrameStage Stage) const { return m_StageHistoryMs[static_cast<uint32_t>(Stage)].data(); }
+    const float* GetTotalHistory() const { return m_TotalHistoryMs.data(); }
+    const float* GetGPUHistory() const { return m_GPUHistoryMs.data(); }
+    uint32_t GetHistoryOffset() const { return m_HistoryCount < HistorySize ? 0 : m_HistoryIndex; }
+    uint32_t GetHistoryCount() const { return m_HistoryCount; }
+    // Durations of the most recently committed frame.
+    float GetLastStageDurationMs(IEFrameStage Stage) const { return m_StageHistoryMs[static_cast<uint32_t>(Stage)][GetLastHistoryIndex()]; }
+    float GetLastTotalDurationMs() const { return m_TotalHistoryMs[GetLastHistoryIndex()]; }
+
+private:
+    uint32_t GetLastHistoryIndex() const { return (m_HistoryIndex + HistorySize - 1) % HistorySize; }
+    static StageStatistics ComputeStatistics(const std::array<float, HistorySize>& History, uint32_t Count);
+
+private:
+    std::array<std::array<float, HistorySize>, StageCount> m_StageHistoryMs = {};
+    std::array<float, HistorySize> m_TotalHistoryMs = {};
+    std::array<float, HistorySize> m_GPUHistoryMs = {};
+    std::array<std::atomic<int64_t>, StageCount> m_CurrentFrameNs = {};
+    std::atomic<float> m_LastGPUFrameDurationMs = 0.0f;
+    std::atomic<bool> m_bHasGPUTimings = false;
+    uint32_t m_HistoryIndex = 0;
+    uint32_t m_HistoryCount = 0;
+};
+
+// Adds the time between construction and Stop() (or destruction) to a frame stage,
+// and records it as a trace event while an IEProfiler capture is running.
+class IEFrameStageTimer
+{
+public:
+#if ENABLE_IE_FRAME_PROFILER
+    IEFrameStageTimer(IEFrameProfiler& _Profiler, IEFrameStage _Stage)
+        : m_Profiler(&_Profiler), m_Stage(_Stage), m_StartTime(IEClock::now())
+    {}
+
+    ~IEFrameStageTimer()
+    {
+        Stop();
+    }
+
+    void Stop()
+    {
+        if (m_Profiler)
+        {
+            const IEClock::time_point EndTime = IEClock::now();
+            m_Profiler->AddStageDuration(m_Stage, std::chrono::duration_cast<std::chrono::nanoseconds>(EndTime - m_StartTime).count());
+#if ENABLE_IE_PROFILER
+            if (Private::bIEProfilerCapturing.load(std::memory_order_relaxed))
+            {
+                Private::IEProfilerRecordEvent(GetIEFrameStageName(m_Stage), m_StartTime, EndTime);
+            }
+#endif
+            m_Profiler = nullptr;
+        }
+    }
+#else
+    IEFrameStageTimer(IEFrameProfiler& _Profiler, IEFrameStage _Stage) {}
+    void Stop() {}
+#endif
+
+    IEFrameStageTimer(const IEFrameStageTimer&) = delete;
+    IEFrameStageTimer& operator=(const IEFrameStageTimer&) = delete;
+
+#if ENABLE_IE_FRAME_PROFILER
+private:
+    IEFrameProfiler* m_Profiler = nullptr;
+    IEFrameStage m_Stage = IEFrameStage::Count;
+    IEClock::time_point m_StartTime;
+#endif
+};
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEInputLayer.h"
+
+#include "IEUtils.h"
+
+#ifndef GLFW_INCLUDE_NONE
+    #define GLFW_INCLUDE_NONE
+#endif
+#include "GLFW/glfw3.h"
+#include "backends/imgui_impl_glfw.h"
+
+static constexpr char IEInputRecordingMagic[4] = { 'I', 'E', 'I', 'R' };
+static constexpr uint32_t IEInputRecordingVersion = 1;
+static constexpr uint8_t IEInputRecordingEndMarker = 0xFF;
+
+IEInputLayer::~IEInputLayer()
+{
+    StopRecording();
+}
+
+void IEInputLayer::PushEvent(const IEInputEvent& Event)
+{
+    if (!m_bReplaying)
+    {
+        if (m_RecordingFile)
+        {
+            WriteRecordedEvent(Event);
+        }
+        QueueEvent(Event);
+    }
+}
+
+void IEInputLayer::QueueEvent(const IEInputEvent& Event)
+{
+    m_PendingReceivedEventCount++;
+
+    IEInputEvent* const LastEvent = m_PendingEvents.empty() ? nullptr : &m_PendingEvents.back();
+    if (Event.Type == IEInputEventType::CursorPos)
+    {
+        m_PendingPointerSamples.push_back({ Event.X, Event.Y, Event.TimestampNs });
+        if (LastEvent && LastEvent->Type == IEInputEventType::CursorPos)
+        {
+            *LastEvent = Event;
+            return;
+        }
+    }
+    else if (Event.Type == IEInputEventType::Scroll && LastEvent && LastEvent->Type == IEInputEventType::Scroll)
+    {
+        LastEvent->X += Event.X;
+        LastEvent->Y += Event.Y;
+        LastEvent->TimestampNs = Event.TimestampNs;
+        return;
+    }
+    m_PendingEvents.push_back(Event);
+}
+
+void IEInputLayer::DispatchEvents(GLFWwindow* Window)
+{
+    if (m_bReplaying)
+    {
+        while (m_ReplayEventIndex < m_ReplayEvents.size() && m_ReplayEvents[m_ReplayEventIndex].FrameIndex <= m_ReplayFrameIndex)
+        {
+            QueueEvent(m_ReplayEvents[m_ReplayEventIndex++].Event);
+        }
+
+        if (++m_ReplayFrameIndex >= m_ReplayFrameCount)
+        {
+            IELOG_CATEGORY_INFO(Frame, "Input replay finished after %u frames", m_ReplayFrameCount);
+            StopReplay();
+        }
+    }
+
+    for (const IEInputEvent& Event : m_PendingEvents)
+    {
+        switch (Event.Type)
+        {
+        case IEInputEventType::CursorPos: ImGui_ImplGlfw_CursorPosCallback(Window, Event.X, Event.Y); break;
+        case IEInputEventType::CursorEnter: ImGui_ImplGlfw_CursorEnterCallback(Window, Event.Code); break;
+        case IEInputEventType::MouseButton: ImGui_ImplGlfw_MouseButtonCallback(Window, Event.Code, Event.Action, Event.Mods); break;
+        case IEInputEventType::Scroll: ImGui_ImplGlfw_ScrollCallback(Window, Event.X, Event.Y); break;
+        case IEInputEventType::Key: ImGui_ImplGlfw_KeyCallback(Window, Event.Code, Event.ScanCode, Event.Action, Event.Mods); break;
+        case IEInputEventType::Char: ImGui_ImplGlfw_CharCallback(Window, static_cast<unsigned int>(Event.Code)); break;
+        case IEInputEventType::Focus: ImGui_ImplGlfw_WindowFocusCallback(Window, Event.Code); break;
+        }
+    }
+
+    m_Statistics.ReceivedEventCount = m_PendingReceivedEventCount;
+    m_Statistics.DispatchedEventCount = static_cast<uint32_t>(m_PendingEvents.size());
+    m_PendingReceivedEventCount = 0;
+    m_PendingEvents.clear();
+
+    // Swapping keeps both buffers' capacity, steady state frames do not allocate
+    m_FramePointerSamples.swap(m_PendingPointerSamples);
+    m_PendingPointerSamples.clear();
+    m_FrameIndex++;
+}
+
+IEResult IEInputLayer::StartRecording(const std::filesystem::path& Path)
+{
+    StopRecording();
+
+    std::filesystem::path RecordingPath = Path;
+    if (RecordingPath.empty())
+    {
+        const int64_t TimestampSeconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        RecordingPath = IEUtils::GetIEConfigFolderPath() / "InputRecordings" / std::format("{}.ieinput", TimestampSeconds);
+    }
+
+    std::error_code ErrorCode;
+    std::filesystem::create_directories(RecordingPath.parent_path(), ErrorCode);
+    m_RecordingFile = std::fopen(RecordingPath.string().c_str(), "wb");
+    if (!m_RecordingFile)
+    {
+        return IEResult(IEResult::Type::Fail, "Failed to open input recording file");
+    }
+
+    std::setvbuf(m_RecordingFile, nullptr, _IOFBF, 64 * 1024);
+    std::fwrite(IEInputRecordingMagic, sizeof(IEInputRecordingMagic), 1, m_RecordingFile);
+    std::fwrite(&IEInputRecordingVersion, sizeof(IEInputRecordingVersion), 1, m_RecordingFile);
+    m_RecordingStartFrameIndex = m_FrameIndex;
+    // Only a base for event timestamps, which are stamped from IEClock, so it has to stay on the same clock
+    m_RecordingStartTimestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(IEClock::now().time_since_epoch()).count();
+    return IEResult(IEResult::Type::Success, "Recording input to " + RecordingPath.string());
+}
+
+void IEInputLayer::StopRecording()
+{
+    if (m_RecordingFile)
+    {
+        // The end marker carries the frame count so replays also cover trailing frames without input
+        const uint32_t FrameCount = static_cast<uint32_t>(m_FrameIndex - m_RecordingStartFrameIndex);
+        std::fwrite(&IEInputRecordingEndMarker, sizeof(IEInputRecordingEndMarker), 1, m_RecordingFile);
+        std::fwrite(&FrameCount, sizeof(FrameCount), 1, m_RecordingFile);
+        std::fclose(m_RecordingFile);
+        m_RecordingFile = nullptr;
+    }
+}
+
+void IEInputLayer::WriteRecordedEvent(const IEInputEvent& Event)
+{
+    // Type, frame and timestamp, then only the fields the event type uses
+    const uint8_t Type = static_cast<uint8_t>(Event.Type);
+    const uint32_t FrameIndex = static_cast<uint32_t>(m_FrameIndex - m_RecordingStartFrameIndex);
+    const int64_t TimestampNs = Event.TimestampNs - m_RecordingStartTimestampNs;
+    std::fwrite(&Type, sizeof(Type), 1, m_RecordingFile);
+    std::fwrite(&FrameIndex, sizeof(FrameIndex), 1, m_RecordingFile);
+    std::fwrite(&TimestampNs, sizeof(TimestampNs), 1, m_RecordingFile);
+
+    switch (Event.Type)
+    {
+    case IEInputEventType::CursorPos:
+    case IEInputEventType::Scroll:
+        std::fwrite(&Event.X, sizeof(Event.X), 1, m_RecordingFile);
+        std::fwrite(&Event.Y, sizeof(Event.Y), 1, m_RecordingFile);
+        break;
+    case IEInputEventType::Key:
+        std::fwrite(&Event.Code, sizeof(Event.Code), 1, m_RecordingFile);
+        std::fwrite(&Event.ScanCode, sizeof(Event.ScanCode), 1, m_RecordingFile);
+        std::fwrite(&Event.Action, sizeof(Event.Action), 1, m_RecordingFile);
+        std::fwrite(&Event.Mods, sizeof(Event.Mods), 1, m_RecordingFile);
+        break;
+    case IEInputEventType::MouseButton:
+        std::fwrite(&Event.Code, sizeof(Event.Code), 1, m_RecordingFile);
+        std::fwrite(&Event.Action, sizeof(Event.Action), 1, m_RecordingFile);
+        std::fwrite(&Event.Mods, sizeof(Event.Mods), 1, m_RecordingFile);
+        break;
+    case IEInputEventType::CursorEnter:
+    case IEInputEventType::Char:
+    case IEInputEventType::Focus:
+        std::fwrite(&Event.Code, sizeof(Event.Code), 1, m_RecordingFile);
+        break;
+    }
+}
+
+IEResult IEInputLayer::StartReplay(const std::filesystem::path& Path)
+{
+    StopReplay();
+
+    FILE* const File = std::fopen(Path.string().c_str(), "rb");
+    if (!File)
+    {
+        return IEResult(IEResult::Type::InvalidArgument, "Failed to open input recording file");
+    }
+
+    char Magic[sizeof(IEInputRecordingMagic)] = {};
+    uint32_t Version = 0;
+    bool bValid = std::fread(Magic, sizeof(Magic), 1, File) == 1 && std::fread(&Version, sizeof(Version), 1, File) == 1 &&
+        std::memcmp(Magic, IEInputRecordingMagic, sizeof(Magic)) == 0 && Version == IEInputRecordingVersion;
+
+    bool bEndReached = false;
+    while (bValid && !bEndReached)
+    {
+        uint8_t Type = 0;
+        if (std::fread(&Type, sizeof(Type), 1, File) != 1)
+        {
+            bValid = false;
+            break;
+        }
+
+        if (Type == IEInputRecordingEndMarker)
+        {
+            bValid = std::fread(&m_ReplayFrameCount, sizeof(m_ReplayFrameCount), 1, File) == 1;
+            bEndReached = true;
+            break;
+        }
+
+        RecordedEvent Recorded;
+        Recorded.Event.Type = static_cast<IEInputEventType>(Type);
+        bValid = std::fread(&Recorded.FrameIndex, sizeof(Recorded.FrameIndex), 1, File) == 1 &&
+            std::fread(&Recorded.Event.TimestampNs, sizeof(Recorded.Event.TimestampNs), 1, File) == 1;
+        switch (Recorded.Event.Type)
+        {
+        case IEInputEventType::CursorPos:
+        case IEInputEventType::Scroll:
+            bValid = bValid && std::fread(&Recorded.Event.X, sizeof(Recorded.Event.X), 1, File) == 1 &&
+                std::fread(&Recorded.Event.Y, sizeof(Recorded.Event.Y), 1, File) == 1;
+            break;
+        case IEInputEventType::Key:
+            bValid = bValid && std::fread(&Recorded.Event.Code, sizeof(Recorded.Event.Code), 1, File) == 1 &&
+                std::fread(&Recorded.Event.ScanCode, sizeof(Recorded.Event.ScanCode), 1, File) == 1 &&
+                std::fread(&Recorded.Event.Action, sizeof(Recorded.Event.Action), 1, File) == 1 &&
+                std::fread(&Recorded.Event.Mods, sizeof(Recorded.Event.Mods), 1, File) == 1;
+            break;
+        case IEInputEventType::MouseButton:
+            bValid = bValid && std::fread(&Recorded.Event.Code, sizeof(Recorded.Event.Code), 1, File) == 1 &&
+                std::fread(&Recorded.Event.Action, sizeof(Recorded.Event.Action), 1, File) == 1 &&
+                std::fread(&Recorded.Event.Mods, sizeof(Recorded.Event.Mods), 1, File) == 1;
+            break;
+        case IEInputEventType::CursorEnter:
+        case IEInputEventType::Char:
+        case IEInputEventType::Focus:
+            bValid = bValid && std::fread(&Recorded.Event.Code, sizeof(Recorded.Event.Code), 1, File) == 1;
+            break;
+        default:
+            bValid = false;
+            break;
+        }
+
+        if (bValid)
+        {
+            m_ReplayEvents.push_back(Recorded);
+        }
+    }
+    std::fclose(File);
+
+    if (!bValid || !bEndReached)
+    {
+        m_ReplayEvents.clear();
+        return IEResult(IEResult::Type::InvalidArgument, "Input recording is truncated or invalid");
+    }
+
+    // Input queued from the live session must not leak into the replay
+    m_PendingEvents.clear();
+    m_PendingPointerSamples.clear();
+    m_PendingReceivedEventCount = 0;
+    m_ReplayEventIndex = 0;
+    m_ReplayFrameIndex = 0;
+    m_bReplaying = true;
+    return IEResult(IEResult::Type::Success, IEResultMessage::Format("Replaying %u frames of input", m_ReplayFrameCount));
+}
+
+void IEInputLayer::StopReplay()
+{
+    m_bReplaying = false;
+    m_ReplayEvents.clear();
+    m_ReplayEventIndex = 0;
+}
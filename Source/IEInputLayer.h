@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IECommon.h"
+
+struct GLFWwindow;
+
+enum class IEInputEventType : uint8_t
+{
+    CursorPos,
+    CursorEnter,
+    MouseButton,
+    Scroll,
+    Key,
+    Char,
+    Focus
+};
+
+struct IEInputEvent
+{
+    IEInputEventType Type = IEInputEventType::CursorPos;
+    int32_t Code = 0; // Button, key, codepoint, or the entered/focused state
+    int32_t ScanCode = 0;
+    int32_t Action = 0;
+    int32_t Mods = 0;
+    double X = 0.0; // Cursor position or scroll offset
+    double Y = 0.0;
+    int64_t TimestampNs = 0;
+};
+
+struct IEPointerSample
+{
+    double X = 0.0;
+    double Y = 0.0;
+    int64_t TimestampNs = 0;
+};
+
+// Owns the GLFW input callbacks in place of the ImGui backend. Events are queued as they arrive and handed to the
+// ImGui GLFW backend once per frame. Consecutive cursor moves collapse into the latest position and consecutive
+// scrolls are summed, every other event keeps its exact order.
+class IEInputLayer
+{
+public:
+    struct Statistics
+    {
+        uint32_t ReceivedEventCount = 0; // Last dispatched frame
+        uint32_t DispatchedEventCount = 0;
+    };
+
+public:
+    ~IEInputLayer();
+
+public:
+    void PushEvent(const IEInputEvent& Event);
+    // Forwards the coalesced queue to ImGui, then exposes this frame's raw pointer samples.
+    void DispatchEvents(GLFWwindow* Window);
+
+    // Every cursor sample received since the previous frame in arrival order, for widgets such as drawing canvases
+    // that need the full device rate. Valid until the next DispatchEvents.
+    const std::vector<IEPointerSample>& GetRawPointerSamples() const { return m_FramePointerSamples; }
+    const Statistics& GetStatistics() const { return m_Statistics; }
+    uint64_t GetFrameIndex() const { return m_FrameIndex; }
+
+    /* Recording and Replay */
+    // Writes every received event with its frame index and timestamp to a compact binary file.
+    // An empty path writes to <IEConfigFolder>/InputRecordings/<timestamp>.ieinput.
+    IEResult StartRecording(const std::filesystem::path& Path = std::filesystem::path());
+    void StopRecording();
+    bool IsRecording() const { return m_RecordingFile != nullptr; }
+
+    // Feeds a recording back, each event on the frame it was originally dispatched, live events are ignored meanwhile.
+    // Replay stops on its own after the last recorded frame.
+    IEResult StartReplay(const std::filesystem::path& Path);
+    void StopReplay();
+    bool IsReplaying() const { return m_bReplaying; }
+
+private:
+    void QueueEvent(const IEInputEvent& Event);
+    void WriteRecordedEvent(const IEInputEvent& Event);
+
+private:
+    struct RecordedEvent
+    {
+        uint32_t FrameIndex = 0;
+        IEInputEvent Event;
+    };
+
+private:
+    std::vector<IEInputEvent> m_PendingEvents;
+    std::vector<IEPointerSample> m_PendingPointerSamples;
+    std::vector<IEPointerSample> m_FramePointerSamples;
+    uint32_t m_PendingReceivedEventCount = 0;
+    Statistics m_Statistics;
+    uint64_t m_FrameIndex = 0;
+
+    FILE* m_RecordingFile = nullptr;
+    uint64_t m_RecordingStartFrameIndex = 0;
+    int64_t m_RecordingStartTimestampNs = 0;
+
+    std::vector<RecordedEvent> m_ReplayEvents;
+    size_t m_ReplayEventIndex = 0;
+    uint32_t m_ReplayFrameIndex = 0;
+    uint32_t m_ReplayFrameCount = 0;
+    bool m_bReplaying = false;
+};
@@ -0,0 +1,1410 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IELogger.h"
+
+#include "IEUtils.h"
+
+/* Logging and Assertions */
+
+namespace Private
+{
+    static constexpr const char* ColorSpecifierReset = "\033[0m";
+    static constexpr const char* ColorSpecifierRed = "\033[31m";
+    static constexpr const char* ColorSpecifierGreen = "\033[32m";
+    static constexpr const char* ColorSpecifierYellow = "\033[33m";
+
+    static constexpr size_t IELogMaxMessageLength = 512;
+
+    static_assert(IELogMaxPayloadSize <= IELogMaxMessageLength, "Binary payloads are stored in the record message buffer.");
+
+    // Text records carry the formatted message, binary records (Site != nullptr) carry the encoded arguments instead.
+    struct IELogRecord
+    {
+        const IELogSite* Site = nullptr;
+        const char* FuncName = nullptr;
+        int LogLevel = 0;
+        int64_t TimestampNs = 0;
+        uint32_t MessageLength = 0;
+        char Message[IELogMaxMessageLength];
+    };
+
+    // Wall clock nanoseconds since the Unix epoch, IEClock may be a steady clock and is only meant for durations
+    static int64_t GetLogTimestampNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static void FormatLogRecordV(IELogRecord& Record, int LogLevel, const char* FuncName, const char* Format, va_list Args)
+    {
+        Record.Site = nullptr;
+        Record.FuncName = FuncName;
+        Record.LogLevel = LogLevel;
+        const int FormattedLength = std::vsnprintf(Record.Message, IELogMaxMessageLength, Format ? Format : "", Args);
+        Record.MessageLength = static_cast<uint32_t>(std::clamp(FormattedLength, 0, static_cast<int>(IELogMaxMessageLength) - 1));
+    }
+
+    static void FillBinaryLogRecord(IELogRecord& Record, const IELogSite& Site, const char* Payload, uint32_t PayloadSize)
+    {
+        Record.Site = &Site;
+        Record.FuncName = Site.FuncName;
+        Record.LogLevel = Site.LogLevel;
+        Record.TimestampNs = GetLogTimestampNs();
+        Record.MessageLength = std::min(PayloadSize, IELogMaxPayloadSize);
+        if (Record.MessageLength > 0)
+        {
+            std::memcpy(Record.Message, Payload, Record.MessageLength);
+        }
+    }
+
+    /* Binary Log Decoding */
+
+    class IELogArgDecoder
+    {
+    public:
+        IELogArgDecoder(const char* _Buffer, uint32_t _Size) : Buffer(_Buffer), Size(_Size) {}
+
+        bool ReadVarint(uint64_t& Value)
+        {
+            Value = 0;
+            for (uint32_t Shift = 0; Offset < Size && Shift < 64; Shift += 7)
+            {
+                const uint8_t Byte = static_cast<uint8_t>(Buffer[Offset++]);
+                Value |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+                if (!(Byte & 0x80))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Formats the next encoded argument with a single printf conversion specification such as "%08.3f".
+        // Formats read back from a .ielog file are untrusted, only flags, width and precision are kept from the specification
+        // and the length modifier is rebuilt from the encoded argument type. %n, '*' and positional arguments are rejected.
+        bool FormatNextArg(std::string_view Specification, std::string& Output)
+        {
+            if (Offset >= Size)
+            {
+                return false;
+            }
+
+            const char Conversion = Specification.size() >= 2 ? Specification.back() : '\0';
+            std::string_view Flags = Specification.size() >= 2 ? Specification.substr(1, Specification.size() - 2) : std::string_view();
+            while (!Flags.empty() && std::strchr("hljztL", Flags.back()))
+            {
+                Flags.remove_suffix(1);
+            }
+            if (Conversion == '\0' || !std::strchr("diouxXeEfFgGaAcsp", Conversion) || Flags.find_first_not_of("-+ #0123456789.") != std::string_view::npos)
+            {
+                // The remaining arguments can no longer be matched to their specifications
+                Offset = Size;
+                Output.append("<?>");
+                return false;
+            }
+
+            char FormattedArg[IELogMaxMessageLength];
+            int FormattedLength = -1;
+            const IELogArgType Type = static_cast<IELogArgType>(Buffer[Offset++]);
+            switch (Type)
+            {
+                case IELogArgType::Int64:
+                case IELogArgType::UInt64:
+                case IELogArgType::Pointer:
+                {
+                    uint64_t Value = 0;
+                    if (ReadVarint(Value))
+                    {
+                        if (Type == IELogArgType::Int64)
+                        {
+                            Value = (Value >> 1) ^ (~(Value & 1) + 1);
+                        }
+
+                        const std::string ArgFormat = "%" + std::string(Flags) + (std::strchr("diouxX", Conversion) ? "ll" : "") + Conversion;
+                        if (std::strchr("eEfFgGaA", Conversion))
+                        {
+                            FormattedLength = std::snprintf(FormattedArg, sizeof(FormattedArg), ArgFormat.c_str(), static_cast<double>(static_cast<int64_t>(Value)));
+                        }
+                        else if (Conversion == 'p')
+                        {
+                            FormattedLength = std::snprintf(FormattedArg, sizeof(FormattedArg), ArgFormat.c_str(), reinterpret_cast<void*>(static_cast<uintptr_t>(Value)));
+                        }
+                        else if (Conversion == 'c')
+                        {
+                            FormattedLength = std::snprintf(FormattedArg, sizeof(FormattedArg), ArgFormat.c_str(), static_cast<int>(Value));
+                        }
+                        else if (Conversion != 's')
+                        {
+                            FormattedLength = std::snprintf(FormattedArg, sizeof(FormattedArg), ArgFormat.c_str(), static_cast<long long>(Value));
+                        }
+                    }
+                    break;
+                }
+                case IELogArgType::Double:
+                {
+                    double Value = 0.0;
+                    if (Offset + sizeof(Value) <= Size)
+                    {
+                        std::memcpy(&Value, Buffer + Offset, sizeof(Value));
+                        Offset += sizeof(Value);
+                        const std::string ArgFormat = "%" + std::string(Flags) + Conversion;
+                        if (std::strchr("eEfFgGaA", Conversion))
+                        {
+                            FormattedLength = std::snprintf(FormattedArg, sizeof(FormattedArg), ArgFormat.c_str(), Value);
+                        }
+                    }
+                    break;
+                }
+                case IELogArgType::String:
+                {
+                    uint64_t Length = 0;
+                    if (ReadVarint(Length))
+                    {
+                        const uint32_t AvailableLength = std::min(static_cast<uint32_t>(Length), Size - Offset);
+                        const std::string Value(Buffer + Offset, AvailableLength);
+                        Offset += AvailableLength;
+                        if (Conversion == 's')
+                        {
+                            const std::string ArgFormat = "%" + std::string(Flags) + Conversion;
+                            FormattedLength = std::snprintf(FormattedArg, sizeof(FormattedArg), ArgFormat.c_str(), Value.c_str());
+                        }
+                    }
+                    break;
+                }
+                default:
+                {
+                    Offset = Size;
+                    break;
+                }
+            }
+
+            if (FormattedLength < 0)
+            {
+                Output.append("<?>");
+                return false;
+            }
+            Output.append(FormattedArg, std::min(static_cast<size_t>(FormattedLength), sizeof(FormattedArg) - 1));
+            return true;
+        }
+
+        bool ReadByte(uint8_t& Byte)
+        {
+            return ReadRaw(&Byte, sizeof(Byte));
+        }
+
+        bool ReadRaw(void* Destination, uint32_t Length)
+        {
+            if (GetRemainingSize() >= Length)
+            {
+                std::memcpy(Destination, Buffer + Offset, Length);
+                Offset += Length;
+                return true;
+            }
+            return false;
+        }
+
+        void Skip(uint32_t Length)
+        {
+            Offset += std::min(Length, GetRemainingSize());
+        }
+
+        uint32_t GetOffset() const { return Offset; }
+        uint32_t GetRemainingSize() const { return Size - Offset; }
+
+    private:
+        const char* Buffer = nullptr;
+        uint32_t Size = 0;
+        uint32_t Offset = 0;
+    };
+
+    // Rebuilds the text a printf call would have produced from a format string and an encoded argument payload.
+    static std::string FormatBinaryPayload(const char* Format, const char* Payload, uint32_t PayloadSize)
+    {
+        std::string Output;
+        IELogArgDecoder Decoder(Payload, PayloadSize);
+        for (const char* Character = Format ? Format : ""; *Character; Character++)
+        {
+            if (*Character != '%')
+            {
+                Output.push_back(*Character);
+                continue;
+            }
+
+            if (*(Character + 1) == '%')
+            {
+                Output.push_back('%');
+                Character++;
+                continue;
+            }
+
+            // Stops at the first character that cannot be a flag, width, precision or length modifier, FormatNextArg validates it
+            const char* SpecificationEnd = Character + 1;
+            while (*SpecificationEnd && std::strchr("-+ #0123456789.hljztL", *SpecificationEnd))
+            {
+                SpecificationEnd++;
+            }
+
+            if (!*SpecificationEnd)
+            {
+                Output.append(Character);
+                break;
+            }
+
+            Decoder.FormatNextArg(std::string_view(Character, SpecificationEnd - Character + 1), Output);
+            Character = SpecificationEnd;
+        }
+        return Output;
+    }
+
+    static void FormatLogRecord(IELogRecord& Record, int LogLevel, const char* FuncName, const char* Format, ...)
+    {
+        va_list Args;
+        va_start(Args, Format);
+        FormatLogRecordV(Record, LogLevel, FuncName, Format, Args);
+        va_end(Args);
+    }
+
+    static void WriteConsoleLogRecord(const IELogRecord& Record)
+    {
+        const char* ColorCode = ColorSpecifierReset;
+        const char* LevelString = "Log";
+        switch (Record.LogLevel)
+        {
+            case -1:
+            {
+                ColorCode = ColorSpecifierRed;
+                LevelString = "Error";
+                break;
+            }
+            case 1:
+            {
+                ColorCode = ColorSpecifierGreen;
+                LevelString = "Success";
+                break;
+            }
+            case 2:
+            {
+                ColorCode = ColorSpecifierYellow;
+                LevelString = "Warning";
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        };
+        if (Record.Site)
+        {
+            const std::string& Message = FormatBinaryPayload(Record.Site->Format, Record.Message, Record.MessageLength);
+            std::fprintf(stdout, "%sIELog %s: %s [%s]%s\n", ColorCode, LevelString,
+                Message.c_str(), Record.FuncName ? Record.FuncName : "", ColorSpecifierReset);
+        }
+        else
+        {
+            std::fprintf(stdout, "%sIELog %s: %.*s [%s]%s\n", ColorCode, LevelString,
+                static_cast<int>(Record.MessageLength), Record.Message, Record.FuncName ? Record.FuncName : "", ColorSpecifierReset);
+        }
+    }
+
+    /* Binary Sink */
+
+    // File layout: "IELB", uint32 version, then a stream of records. Site definitions are written the first time
+    // a site ID shows up so the decoder never needs the binary that produced the log.
+    static constexpr char IELogBinaryMagic[4] = { 'I', 'E', 'L', 'B' };
+    static constexpr uint32_t IELogBinaryVersion = 1;
+
+    enum class IELogBinaryRecordKind : uint8_t
+    {
+        SiteDefinition = 1, // uint32 ID, int8 level, varint length + format, varint length + function name
+        Event = 2,          // uint32 ID, zigzag varint timestamp delta (ns), varint length + encoded arguments
+        Text = 3            // int8 level, zigzag varint timestamp delta (ns), varint length + function name, varint length + message
+    };
+
+    class IELogBinarySink
+    {
+    public:
+        IEResult Open(const std::filesystem::path& Path)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            CloseInternal();
+
+            std::error_code ErrorCode;
+            std::filesystem::create_directories(Path.parent_path(), ErrorCode);
+            m_File = std::fopen(Path.string().c_str(), "wb");
+            if (!m_File)
+            {
+                return IEResult(IEResult::Type::Fail, "Failed to open binary log file");
+            }
+
+            std::setvbuf(m_File, nullptr, _IOFBF, 64 * 1024);
+            std::fwrite(IELogBinaryMagic, sizeof(IELogBinaryMagic), 1, m_File);
+            std::fwrite(&IELogBinaryVersion, sizeof(IELogBinaryVersion), 1, m_File);
+            m_DefinedSiteIDs.clear();
+            m_PreviousTimestampNs = 0;
+            return IEResult(IEResult::Type::Success, "Opened binary log file");
+        }
+
+        void Close()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            CloseInternal();
+        }
+
+        bool IsOpen()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            return m_File != nullptr;
+        }
+
+        bool Write(const IELogRecord& Record)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (!m_File)
+            {
+                return false;
+            }
+
+            if (Record.Site)
+            {
+                if (m_DefinedSiteIDs.insert(Record.Site->ID).second)
+                {
+                    WriteByte(static_cast<uint8_t>(IELogBinaryRecordKind::SiteDefinition));
+                    std::fwrite(&Record.Site->ID, sizeof(Record.Site->ID), 1, m_File);
+                    WriteByte(static_cast<uint8_t>(static_cast<int8_t>(Record.Site->LogLevel)));
+                    WriteString(Record.Site->Format, std::strlen(Record.Site->Format));
+                    WriteString(Record.Site->FuncName, std::strlen(Record.Site->FuncName));
+                }
+
+                WriteByte(static_cast<uint8_t>(IELogBinaryRecordKind::Event));
+                std::fwrite(&Record.Site->ID, sizeof(Record.Site->ID), 1, m_File);
+                WriteTimestamp(Record.TimestampNs);
+                WriteString(Record.Message, Record.MessageLength);
+            }
+            else
+            {
+                const char* FuncName = Record.FuncName ? Record.FuncName : "";
+                WriteByte(static_cast<uint8_t>(IELogBinaryRecordKind::Text));
+                WriteByte(static_cast<uint8_t>(static_cast<int8_t>(Record.LogLevel)));
+                WriteTimestamp(Record.TimestampNs ? Record.TimestampNs : GetLogTimestampNs());
+                WriteString(FuncName, std::strlen(FuncName));
+                WriteString(Record.Message, Record.MessageLength);
+            }
+            return true;
+        }
+
+        void Flush()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (m_File)
+            {
+                std::fflush(m_File);
+            }
+        }
+
+    private:
+        void CloseInternal()
+        {
+            if (m_File)
+            {
+                std::fclose(m_File);
+                m_File = nullptr;
+            }
+        }
+
+        void WriteByte(uint8_t Byte)
+        {
+            std::fputc(Byte, m_File);
+        }
+
+        void WriteVarint(uint64_t Value)
+        {
+            uint8_t Bytes[10];
+            size_t ByteCount = 0;
+            do
+            {
+                const uint8_t Byte = static_cast<uint8_t>(Value & 0x7F);
+                Value >>= 7;
+                Bytes[ByteCount++] = Value ? (Byte | 0x80) : Byte;
+            } while (Value);
+            std::fwrite(Bytes, 1, ByteCount, m_File);
+        }
+
+        void WriteTimestamp(int64_t TimestampNs)
+        {
+            const int64_t Delta = TimestampNs - m_PreviousTimestampNs;
+            WriteVarint((static_cast<uint64_t>(Delta) << 1) ^ static_cast<uint64_t>(Delta >> 63));
+            m_PreviousTimestampNs = TimestampNs;
+        }
+
+        void WriteString(const char* String, size_t Length)
+        {
+            WriteVarint(Length);
+            std::fwrite(String, 1, Length, m_File);
+        }
+
+    private:
+        FILE* m_File = nullptr;
+        std::unordered_set<uint32_t> m_DefinedSiteIDs;
+        int64_t m_PreviousTimestampNs = 0;
+        std::mutex m_Mutex;
+    };
+
+    static IELogBinarySink& GetBinarySink()
+    {
+        static IELogBinarySink BinarySink;
+        return BinarySink;
+    }
+
+    /* Memory-mapped File Sink */
+
+    // Text lines are copied straight into a preallocated shared mapping, the page cache writes them back so there is
+    // no syscall per line and everything already copied survives a crash of the process.
+    class IELogMappedFileSink
+    {
+    public:
+        IEResult Open(const IELogger::FileSinkConfig& Config)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            CloseInternal();
+
+            m_Config = Config;
+            m_Config.MaxFileSize = std::max<uint64_t>(m_Config.MaxFileSize, 64 * 1024);
+            m_Config.MaxFileCount = std::max<uint32_t>(m_Config.MaxFileCount, 1);
+            if (m_Config.Directory.empty())
+            {
+                m_Config.Directory = IEUtils::GetIEConfigFolderPath() / "Logs";
+            }
+
+            std::error_code ErrorCode;
+            std::filesystem::create_directories(m_Config.Directory, ErrorCode);
+            if (!RotateAndMapInternal())
+            {
+                return IEResult(IEResult::Type::Fail, "Failed to map log file");
+            }
+
+            m_bMirrorToConsole.store(m_Config.bMirrorToConsole, std::memory_order_relaxed);
+            m_bOpen.store(true, std::memory_order_release);
+            return IEResult(IEResult::Type::Success, "Opened memory-mapped log file");
+        }
+
+        void Close()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            CloseInternal();
+        }
+
+        bool IsOpen() const
+        {
+            return m_bOpen.load(std::memory_order_acquire);
+        }
+
+        bool ShouldMirrorToConsole() const
+        {
+            return m_bMirrorToConsole.load(std::memory_order_relaxed);
+        }
+
+        void Write(const IELogRecord& Record)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (!m_MappedData)
+            {
+                return;
+            }
+
+            static constexpr const char* LevelStrings[] = { "Error", "Log", "Success", "Warning" };
+            const int64_t TimestampNs = Record.TimestampNs ? Record.TimestampNs : GetLogTimestampNs();
+            const std::time_t TimestampSeconds = static_cast<std::time_t>(TimestampNs / 1000000000);
+            char TimeString[32] = {};
+            if (const std::tm* const LocalTime = std::localtime(&TimestampSeconds))
+            {
+                std::strftime(TimeString, sizeof(TimeString), "%Y-%m-%d %H:%M:%S", LocalTime);
+            }
+
+            char Line[IELogMaxMessageLength * 2];
+            const std::string& Message = Record.Site ? FormatBinaryPayload(Record.Site->Format, Record.Message, Record.MessageLength) :
+                std::string(Record.Message, Record.MessageLength);
+            const int LineLength = std::snprintf(Line, sizeof(Line), "[%s.%06lld] IELog %s: %s [%s]\n", TimeString,
+                static_cast<long long>((TimestampNs % 1000000000) / 1000), LevelStrings[std::clamp(Record.LogLevel + 1, 0, 3)],
+                Message.c_str(), Record.FuncName ? Record.FuncName : "");
+            if (LineLength <= 0)
+            {
+                return;
+            }
+
+            const uint64_t WriteLength = std::min<uint64_t>(static_cast<uint64_t>(LineLength), sizeof(Line) - 1);
+            if (m_WriteOffset + WriteLength > m_Config.MaxFileSize && !RotateAndMapInternal())
+            {
+                return;
+            }
+
+            std::memcpy(m_MappedData + m_WriteOffset, Line, WriteLength);
+            m_WriteOffset += WriteLength;
+        }
+
+    private:
+        std::filesystem::path GetRotatedFilePath(uint32_t Index) const
+        {
+            return m_Config.Directory / (Index == 0 ? std::format("{}.log", m_Config.BaseName) : std::format("{}.{}.log", m_Config.BaseName, Index));
+        }
+
+        // Shifts <BaseName>.log -> <BaseName>.1.log ... dropping the oldest file, then maps a fresh <BaseName>.log
+        bool RotateAndMapInternal()
+        {
+            UnmapInternal();
+
+            std::error_code ErrorCode;
+            std::filesystem::remove(GetRotatedFilePath(m_Config.MaxFileCount - 1), ErrorCode);
+            for (uint32_t Index = m_Config.MaxFileCount - 1; Index > 0; Index--)
+            {
+                if (std::filesystem::exists(GetRotatedFilePath(Index - 1), ErrorCode))
+                {
+                    std::filesystem::rename(GetRotatedFilePath(Index - 1), GetRotatedFilePath(Index), ErrorCode);
+                }
+            }
+            return MapInternal(GetRotatedFilePath(0));
+        }
+
+        bool MapInternal(const std::filesystem::path& Path)
+        {
+            m_WriteOffset = 0;
+#if defined (_WIN32)
+            m_FileHandle = CreateFileW(Path.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_FileHandle != INVALID_HANDLE_VALUE)
+            {
+                const DWORD SizeHigh = static_cast<DWORD>(m_Config.MaxFileSize >> 32);
+                const DWORD SizeLow = static_cast<DWORD>(m_Config.MaxFileSize & 0xFFFFFFFF);
+                m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, PAGE_READWRITE, SizeHigh, SizeLow, nullptr);
+                if (m_MappingHandle)
+                {
+                    m_MappedData = static_cast<char*>(MapViewOfFile(m_MappingHandle, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(m_Config.MaxFileSize)));
+                }
+            }
+#elif defined(__APPLE__) || defined(__linux__)
+            m_FileDescriptor = open(Path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (m_FileDescriptor >= 0 && ftruncate(m_FileDescriptor, static_cast<off_t>(m_Config.MaxFileSize)) == 0)
+            {
+                void* const MappedData = mmap(nullptr, static_cast<size_t>(m_Config.MaxFileSize), PROT_READ | PROT_WRITE, MAP_SHARED, m_FileDescriptor, 0);
+                m_MappedData = MappedData != MAP_FAILED ? static_cast<char*>(MappedData) : nullptr;
+            }
+#endif
+            if (!m_MappedData)
+            {
+                UnmapInternal();
+            }
+            return m_MappedData != nullptr;
+        }
+
+        // Unmaps the current file and trims the preallocated tail so closed logs only contain written lines.
+        void UnmapInternal()
+        {
+#if defined (_WIN32)
+            if (m_MappedData)
+            {
+                UnmapViewOfFile(m_MappedData);
+            }
+            if (m_MappingHandle)
+            {
+                CloseHandle(m_MappingHandle);
+                m_MappingHandle = nullptr;
+            }
+            if (m_FileHandle != INVALID_HANDLE_VALUE)
+            {
+                LARGE_INTEGER WrittenSize;
+                WrittenSize.QuadPart = static_cast<LONGLONG>(m_WriteOffset);
+                if (SetFilePointerEx(m_FileHandle, WrittenSize, nullptr, FILE_BEGIN))
+                {
+                    SetEndOfFile(m_FileHandle);
+                }
+                CloseHandle(m_FileHandle);
+                m_FileHandle = INVALID_HANDLE_VALUE;
+            }
+#elif defined(__APPLE__) || defined(__linux__)
+            if (m_MappedData)
+            {
+                munmap(m_MappedData, static_cast<size_t>(m_Config.MaxFileSize));
+            }
+            if (m_FileDescriptor >= 0)
+            {
+                if (ftruncate(m_FileDescriptor, static_cast<off_t>(m_WriteOffset)) != 0)
+                {
+                    std::fprintf(stderr, "IELogger: Failed to trim log file\n");
+                }
+                close(m_FileDescriptor);
+                m_FileDescriptor = -1;
+            }
+#endif
+            m_MappedData = nullptr;
+            m_WriteOffset = 0;
+        }
+
+        void CloseInternal()
+        {
+            m_bOpen.store(false, std::memory_order_release);
+            UnmapInternal();
+        }
+
+    private:
+        IELogger::FileSinkConfig m_Config;
+        char* m_MappedData = nullptr;
+        uint64_t m_WriteOffset = 0;
+#if defined (_WIN32)
+        HANDLE m_FileHandle = INVALID_HANDLE_VALUE;
+        HANDLE m_MappingHandle = nullptr;
+#elif defined(__APPLE__) || defined(__linux__)
+        int m_FileDescriptor = -1;
+#endif
+        std::atomic<bool> m_bOpen = false;
+        std::atomic<bool> m_bMirrorToConsole = true;
+        std::mutex m_Mutex;
+    };
+
+    static IELogMappedFileSink& GetMappedFileSink()
+    {
+        static IELogMappedFileSink MappedFileSink;
+        return MappedFileSink;
+    }
+
+    static void WriteLogRecordToSinks(const IELogRecord& Record)
+    {
+        if (!bIELogBinaryEnabled.load(std::memory_order_relaxed) || !GetBinarySink().Write(Record))
+        {
+            IELogMappedFileSink& MappedFileSink = GetMappedFileSink();
+            if (MappedFileSink.IsOpen())
+            {
+                MappedFileSink.Write(Record);
+                if (MappedFileSink.ShouldMirrorToConsole())
+                {
+                    WriteConsoleLogRecord(Record);
+                }
+            }
+            else
+            {
+                WriteConsoleLogRecord(Record);
+            }
+        }
+    }
+
+    static void WriteRawToStandardError(const char* Data, size_t Length)
+    {
+#if defined (_WIN32)
+        _write(2, Data, static_cast<unsigned int>(Length));
+#elif defined(__APPLE__) || defined(__linux__)
+        while (Length > 0)
+        {
+            const ssize_t WrittenLength = write(STDERR_FILENO, Data, Length);
+            if (WrittenLength <= 0)
+            {
+                break;
+            }
+            Data += WrittenLength;
+            Length -= static_cast<size_t>(WrittenLength);
+        }
+#endif
+    }
+
+    /* Deduplication */
+
+    // Folds identical consecutive records (same site, level and message) into a single "repeated N times" record,
+    // written as soon as a different record arrives, the logger is flushed or the fold gets older than RepeatFlushInterval.
+    class IELogDeduplicator
+    {
+    public:
+        // A fault logged every frame still shows up about once per interval while it lasts
+        static constexpr std::chrono::milliseconds RepeatFlushInterval = std::chrono::milliseconds(1000);
+
+        void Write(const IELogRecord& Record)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (m_bEnabled.load(std::memory_order_relaxed) && m_bHasLastRecord && IsLastRecord(Record))
+            {
+                const IEClock::time_point Now = IEClock::now();
+                if (m_RepeatCount.fetch_add(1, std::memory_order_relaxed) == 0)
+                {
+                    m_RepeatStartTime = Now;
+                }
+                else if (Now - m_RepeatStartTime >= RepeatFlushInterval)
+                {
+                    WriteRepeatedRecord();
+                }
+                return;
+            }
+
+            WriteRepeatedRecord();
+            WriteLogRecordToSinks(Record);
+
+            m_LastRecord.Site = Record.Site;
+            m_LastRecord.FuncName = Record.FuncName;
+            m_LastRecord.LogLevel = Record.LogLevel;
+            m_LastRecord.MessageLength = Record.MessageLength;
+            std::memcpy(m_LastRecord.Message, Record.Message, Record.MessageLength);
+            m_bHasLastRecord = true;
+        }
+
+        void FlushRepeatedRecord()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            WriteRepeatedRecord();
+        }
+
+        void SetEnabled(bool bEnabled)
+        {
+            m_bEnabled.store(bEnabled, std::memory_order_relaxed);
+        }
+
+        // Async-signal-safe, takes the pending count without locking so it is written at most once
+        void WriteRepeatedRecordRaw()
+        {
+            const uint64_t RepeatCount = m_RepeatCount.exchange(0, std::memory_order_relaxed);
+            if (RepeatCount > 0)
+            {
+                char CountText[20];
+                size_t CountLength = 0;
+                for (uint64_t Remaining = RepeatCount; Remaining > 0; Remaining /= 10)
+                {
+                    CountText[sizeof(CountText) - ++CountLength] = static_cast<char>('0' + Remaining % 10);
+                }
+
+                static constexpr char Prefix[] = "Previous message repeated ";
+                static constexpr char Suffix[] = " times\n";
+                WriteRawToStandardError(Prefix, sizeof(Prefix) - 1);
+                WriteRawToStandardError(CountText + sizeof(CountText) - CountLength, CountLength);
+                WriteRawToStandardError(Suffix, sizeof(Suffix) - 1);
+            }
+        }
+
+    private:
+        bool IsLastRecord(const IELogRecord& Record) const
+        {
+            return Record.Site == m_LastRecord.Site &&
+                Record.FuncName == m_LastRecord.FuncName &&
+                Record.LogLevel == m_LastRecord.LogLevel &&
+                Record.MessageLength == m_LastRecord.MessageLength &&
+                std::memcmp(Record.Message, m_LastRecord.Message, Record.MessageLength) == 0;
+        }
+
+        void WriteRepeatedRecord()
+        {
+            const uint64_t RepeatCount = m_RepeatCount.exchange(0, std::memory_order_relaxed);
+            if (RepeatCount > 0)
+            {
+                IELogRecord RepeatedRecord;
+                FormatLogRecord(RepeatedRecord, m_LastRecord.LogLevel, m_LastRecord.FuncName, "Previous message repeated %llu times",
+                    static_cast<unsigned long long>(RepeatCount));
+                WriteLogRecordToSinks(RepeatedRecord);
+            }
+        }
+
+    private:
+        IELogRecord m_LastRecord;
+        bool m_bHasLastRecord = false;
+        IEClock::time_point m_RepeatStartTime;
+        std::atomic<uint64_t> m_RepeatCount = 0;
+        std::atomic<bool> m_bEnabled = true;
+        std::mutex m_Mutex;
+    };
+
+    static IELogDeduplicator& GetDeduplicator()
+    {
+        static IELogDeduplicator Deduplicator;
+        static const bool bFlushOnExitRegistered = (std::atexit([]() { GetDeduplicator().FlushRepeatedRecord(); std::fflush(stdout); }) == 0);
+        (void)bFlushOnExitRegistered;
+        return Deduplicator;
+    }
+
+    static void WriteLogRecord(const IELogRecord& Record)
+    {
+        GetDeduplicator().Write(Record);
+    }
+
+    static void FlushLogSinks(bool bFlushRepeatedRecord = true)
+    {
+        if (bFlushRepeatedRecord)
+        {
+            GetDeduplicator().FlushRepeatedRecord();
+        }
+        GetBinarySink().Flush();
+        std::fflush(stdout);
+    }
+
+    /* Asynchronous Backend */
+
+    // Bounded multi-producer ring buffer (Vyukov), each slot carries a sequence number that tells
+    // producers and consumers whether it is free, being written or ready to be written out.
+    class IELogAsyncBackend
+    {
+    public:
+        ~IELogAsyncBackend()
+        {
+            // Without bFlushOnExit nothing stops the writer before static destruction, a joinable std::thread would terminate
+            Stop();
+        }
+
+        IEResult Start(const IELogger::AsyncConfig& Config)
+        {
+            std::lock_guard<std::mutex> Lock(m_ControlMutex);
+            if (m_bEnabled.load())
+            {
+                return IEResult(IEResult::Type::InvalidArgument, "Asynchronous logging is already running");
+            }
+
+            const uint64_t Capacity = std::bit_ceil(std::max<uint64_t>(Config.Capacity, 2));
+            m_Slots = std::make_unique<Slot[]>(Capacity);
+            for (uint64_t i = 0; i < Capacity; i++)
+            {
+                m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+            }
+            m_Mask = Capacity - 1;
+            m_Overflow = Config.Overflow;
+            m_EnqueuePos.store(0, std::memory_order_relaxed);
+            m_DequeuePos.store(0, std::memory_order_relaxed);
+            m_WrittenCount.store(0, std::memory_order_relaxed);
+            m_bStopRequested.store(false, std::memory_order_relaxed);
+
+            m_WriterThread = std::thread(&IELogAsyncBackend::WriterLoop, this);
+            m_bEnabled.store(true);
+
+            return IEResult(IEResult::Type::Success, "Started asynchronous logging");
+        }
+
+        void Stop()
+        {
+            std::lock_guard<std::mutex> Lock(m_ControlMutex);
+            if (m_bEnabled.load())
+            {
+                m_bEnabled.store(false);
+                while (m_ActiveProducers.load() != 0)
+                {
+                    std::this_thread::yield();
+                }
+
+                m_bStopRequested.store(true, std::memory_order_release);
+                WakeWriter();
+                if (m_WriterThread.joinable())
+                {
+                    m_WriterThread.join();
+                }
+
+                Drain();
+                ReportDroppedRecords();
+                FlushLogSinks();
+                m_Slots.reset();
+            }
+        }
+
+        bool IsEnabled() const
+        {
+            return m_bEnabled.load(std::memory_order_relaxed);
+        }
+
+        template<typename FillRecordFuncType>
+        bool TryPush(FillRecordFuncType&& FillRecord)
+        {
+            m_ActiveProducers.fetch_add(1);
+            if (!m_bEnabled.load())
+            {
+                m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+                return false;
+            }
+
+            uint64_t Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+            Slot* TargetSlot = nullptr;
+            while (!TargetSlot)
+            {
+                Slot& CandidateSlot = m_Slots[Pos & m_Mask];
+                const uint64_t Sequence = CandidateSlot.Sequence.load(std::memory_order_acquire);
+                const int64_t Difference = static_cast<int64_t>(Sequence) - static_cast<int64_t>(Pos);
+                if (Difference == 0)
+                {
+                    if (m_EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                    {
+                        TargetSlot = &CandidateSlot;
+                    }
+                }
+                else if (Difference < 0)
+                {
+                    if (m_Overflow == IELogger::OverflowPolicy::Drop)
+                    {
+                        m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+                        m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+                        return true;
+                    }
+                    WakeWriter();
+                    std::this_thread::yield();
+                    Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+                }
+                else
+                {
+                    Pos = m_EnqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            FillRecord(TargetSlot->Record);
+            TargetSlot->Sequence.store(Pos + 1, std::memory_order_release);
+            WakeWriter();
+
+            m_ActiveProducers.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        void Flush()
+        {
+            if (m_bEnabled.load())
+            {
+                const uint64_t TargetCount = m_EnqueuePos.load(std::memory_order_acquire);
+                uint64_t WrittenCount = m_WrittenCount.load(std::memory_order_acquire);
+                while (WrittenCount < TargetCount && m_bEnabled.load())
+                {
+                    WakeWriter();
+                    m_WrittenCount.wait(WrittenCount, std::memory_order_acquire);
+                    WrittenCount = m_WrittenCount.load(std::memory_order_acquire);
+                }
+            }
+            FlushLogSinks();
+        }
+
+        // Safe to call from any thread, concurrently with the writer thread. Not async-signal-safe, sinks lock and allocate.
+        size_t Drain()
+        {
+            size_t WrittenRecordCount = 0;
+            if (m_Slots)
+            {
+                uint64_t Pos = m_DequeuePos.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    Slot& CandidateSlot = m_Slots[Pos & m_Mask];
+                    const uint64_t Sequence = CandidateSlot.Sequence.load(std::memory_order_acquire);
+                    const int64_t Difference = static_cast<int64_t>(Sequence) - static_cast<int64_t>(Pos + 1);
+                    if (Difference == 0)
+                    {
+                        if (m_DequeuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+                        {
+                            WriteLogRecord(CandidateSlot.Record);
+                            CandidateSlot.Sequence.store(Pos + m_Mask + 1, std::memory_order_release);
+                            m_WrittenCount.fetch_add(1, std::memory_order_release);
+                            WrittenRecordCount++;
+                            Pos++;
+                        }
+                    }
+                    else if (Difference < 0)
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        Pos = m_DequeuePos.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+            return WrittenRecordCount;
+        }
+
+        uint64_t GetDroppedCount() const
+        {
+            return m_DroppedCount.load(std::memory_order_relaxed);
+        }
+
+        // Async-signal-safe, no locks, allocations or stdio. Writes the text of every committed record still in the ring to stderr,
+        // binary records only carry encoded arguments and are skipped. Records racing with the writer thread may be written twice.
+        void WritePendingRecordsRaw() const
+        {
+            if (m_Slots)
+            {
+                for (uint64_t Pos = m_DequeuePos.load(std::memory_order_acquire); ; Pos++)
+                {
+                    const Slot& CandidateSlot = m_Slots[Pos & m_Mask];
+                    if (CandidateSlot.Sequence.load(std::memory_order_acquire) != Pos + 1)
+                    {
+                        break;
+                    }
+                    if (!CandidateSlot.Record.Site)
+                    {
+                        WriteRawToStandardError(CandidateSlot.Record.Message, CandidateSlot.Record.MessageLength);
+                        WriteRawToStandardError("\n", 1);
+                    }
+                }
+            }
+        }
+
+    private:
+        void WriterLoop()
+        {
+            while (true)
+            {
+                const uint32_t WakeSignal = m_WakeSignal.load(std::memory_order_acquire);
+                if (Drain() > 0)
+                {
+                    ReportDroppedRecords();
+                    FlushLogSinks(false);
+                    m_WrittenCount.notify_all();
+                    continue;
+                }
+
+                if (m_bStopRequested.load(std::memory_order_acquire))
+                {
+                    break;
+                }
+                m_WakeSignal.wait(WakeSignal, std::memory_order_acquire);
+            }
+            m_WrittenCount.notify_all();
+        }
+
+        void WakeWriter()
+        {
+            m_WakeSignal.fetch_add(1, std::memory_order_release);
+            m_WakeSignal.notify_one();
+        }
+
+        void ReportDroppedRecords()
+        {
+            const uint64_t DroppedCount = m_DroppedCount.load(std::memory_order_relaxed);
+            if (DroppedCount != m_ReportedDroppedCount)
+            {
+                IELogRecord Record;
+                FormatLogRecord(Record, 2, "IELogger", "Dropped %llu log records, ring buffer was full",
+                    static_cast<unsigned long long>(DroppedCount - m_ReportedDroppedCount));
+                WriteLogRecord(Record);
+                m_ReportedDroppedCount = DroppedCount;
+            }
+        }
+
+    private:
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> Sequence = 0;
+            IELogRecord Record;
+        };
+
+        std::unique_ptr<Slot[]> m_Slots;
+        uint64_t m_Mask = 0;
+        IELogger::OverflowPolicy m_Overflow = IELogger::OverflowPolicy::Drop;
+
+        alignas(64) std::atomic<uint64_t> m_EnqueuePos = 0;
+        alignas(64) std::atomic<uint64_t> m_DequeuePos = 0;
+        alignas(64) std::atomic<uint64_t> m_WrittenCount = 0;
+        alignas(64) std::atomic<uint32_t> m_WakeSignal = 0;
+        alignas(64) std::atomic<uint32_t> m_ActiveProducers = 0;
+        std::atomic<uint64_t> m_DroppedCount = 0;
+        std::atomic<bool> m_bEnabled = false;
+        std::atomic<bool> m_bStopRequested = false;
+
+        uint64_t m_ReportedDroppedCount = 0;
+        std::thread m_WriterThread;
+        std::mutex m_ControlMutex;
+    };
+
+    static IELogAsyncBackend& GetAsyncBackend()
+    {
+        // The sinks are constructed first so they outlive the backend, its destructor drains into them
+        static const bool bSinksConstructed = (GetDeduplicator(), GetBinarySink(), GetMappedFileSink(), true);
+        (void)bSinksConstructed;
+        static IELogAsyncBackend AsyncBackend;
+        return AsyncBackend;
+    }
+
+    static void FlushOnExit()
+    {
+        IELogger::StopAsync();
+    }
+
+    static std::terminate_handler PreviousTerminateHandler = nullptr;
+
+    static void FlushOnTerminate()
+    {
+        // Runs as a regular function on the terminating thread, unlike FlushOnAbort it may lock and allocate
+        GetAsyncBackend().Drain();
+        FlushLogSinks();
+        if (PreviousTerminateHandler)
+        {
+            PreviousTerminateHandler();
+        }
+        std::abort();
+    }
+
+    static void FlushOnAbort(int Signal)
+    {
+        // Only async-signal-safe work here, a thread may hold a sink lock when abort is raised. The mapped file sink
+        // needs nothing, its MAP_SHARED pages reach the file without a flush.
+        GetDeduplicator().WriteRepeatedRecordRaw();
+        GetAsyncBackend().WritePendingRecordsRaw();
+        std::signal(Signal, SIG_DFL);
+        std::raise(Signal);
+    }
+
+    void IELog(int LogLevel, const char* FuncName, const char* Format, ...)
+    {
+        va_list Args;
+        va_start(Args, Format);
+        auto FillRecord = [&](IELogRecord& Record)
+            {
+                FormatLogRecordV(Record, LogLevel, FuncName, Format, Args);
+                Record.TimestampNs = GetLogTimestampNs();
+            };
+
+        if (!GetAsyncBackend().TryPush(FillRecord))
+        {
+            IELogRecord Record;
+            FillRecord(Record);
+            WriteLogRecord(Record);
+        }
+        va_end(Args);
+    }
+
+    std::string FormatIELogPayload(const char* Format, const char* Payload, uint32_t PayloadSize)
+    {
+        return FormatBinaryPayload(Format, Payload, PayloadSize);
+    }
+
+    void IELogBinary(const IELogSite& Site, const char* Payload, uint32_t PayloadSize)
+    {
+        auto FillRecord = [&](IELogRecord& Record)
+            {
+                FillBinaryLogRecord(Record, Site, Payload, PayloadSize);
+            };
+
+        if (!GetAsyncBackend().TryPush(FillRecord))
+        {
+            IELogRecord Record;
+            FillRecord(Record);
+            WriteLogRecord(Record);
+        }
+    }
+}
+
+namespace IELogger
+{
+    IEResult StartAsync(const AsyncConfig& Config)
+    {
+        IEResult Result = Private::GetAsyncBackend().Start(Config);
+        if (Result.Type == IEResult::Type::Success)
+        {
+            static std::once_flag ExitHookFlag;
+            if (Config.bFlushOnExit)
+            {
+                std::call_once(ExitHookFlag, []() { std::atexit(&Private::FlushOnExit); });
+            }
+
+            if (Config.bFlushOnAbort)
+            {
+                static std::once_flag TerminateHookFlag;
+                std::call_once(TerminateHookFlag, []() { Private::PreviousTerminateHandler = std::set_terminate(&Private::FlushOnTerminate); });
+                std::signal(SIGABRT, &Private::FlushOnAbort);
+            }
+        }
+        return Result;
+    }
+
+    void StopAsync()
+    {
+        Private::GetAsyncBackend().Stop();
+    }
+
+    bool IsAsync()
+    {
+        return Private::GetAsyncBackend().IsEnabled();
+    }
+
+    void Flush()
+    {
+        Private::GetAsyncBackend().Flush();
+    }
+
+    uint64_t GetDroppedRecordCount()
+    {
+        return Private::GetAsyncBackend().GetDroppedCount();
+    }
+
+    IEResult StartBinary(const std::filesystem::path& Path)
+    {
+        std::filesystem::path BinaryLogPath = Path;
+        if (BinaryLogPath.empty())
+        {
+            const int64_t TimestampSeconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            BinaryLogPath = IEUtils::GetIEConfigFolderPath() / "Logs" / std::format("{}.ielog", TimestampSeconds);
+        }
+
+        IEResult Result = Private::GetBinarySink().Open(BinaryLogPath);
+        if (Result.Type == IEResult::Type::Success)
+        {
+            Private::bIELogBinaryEnabled.store(true);
+        }
+        return Result;
+    }
+
+    void StopBinary()
+    {
+        Flush();
+        Private::bIELogBinaryEnabled.store(false);
+        Flush();
+        Private::GetBinarySink().Close();
+    }
+
+    bool IsBinary()
+    {
+        return Private::bIELogBinaryEnabled.load(std::memory_order_relaxed);
+    }
+
+    void SetDeduplicationEnabled(bool bEnabled)
+    {
+        Private::GetDeduplicator().SetEnabled(bEnabled);
+    }
+
+    IEResult StartFileSink(const FileSinkConfig& Config)
+    {
+        return Private::GetMappedFileSink().Open(Config);
+    }
+
+    void StopFileSink()
+    {
+        Flush();
+        Private::GetMappedFileSink().Close();
+    }
+
+    bool IsFileSinkOpen()
+    {
+        return Private::GetMappedFileSink().IsOpen();
+    }
+
+    IEResult DecodeBinaryLog(const std::filesystem::path& Path, FILE* Output)
+    {
+        std::vector<char> Contents;
+        if (FILE* const File = std::fopen(Path.string().c_str(), "rb"))
+        {
+            char ReadBuffer[64 * 1024];
+            size_t ReadSize = 0;
+            while ((ReadSize = std::fread(ReadBuffer, 1, sizeof(ReadBuffer), File)) > 0)
+            {
+                Contents.insert(Contents.end(), ReadBuffer, ReadBuffer + ReadSize);
+            }
+            std::fclose(File);
+        }
+        else
+        {
+            return IEResult(IEResult::Type::InvalidArgument, "Failed to open binary log file");
+        }
+
+        uint32_t Version = 0;
+        const size_t HeaderSize = sizeof(Private::IELogBinaryMagic) + sizeof(Version);
+        if (Contents.size() < HeaderSize || std::memcmp(Contents.data(), Private::IELogBinaryMagic, sizeof(Private::IELogBinaryMagic)) != 0)
+        {
+            return IEResult(IEResult::Type::InvalidArgument, "File is not an IE binary log");
+        }
+
+        std::memcpy(&Version, Contents.data() + sizeof(Private::IELogBinaryMagic), sizeof(Version));
+        if (Version != Private::IELogBinaryVersion)
+        {
+            return IEResult(IEResult::Type::NotSupported, "Unsupported IE binary log version");
+        }
+
+        struct DecodedSite
+        {
+            int LogLevel = 0;
+            std::string Format;
+            std::string FuncName;
+        };
+        std::unordered_map<uint32_t, DecodedSite> Sites;
+
+        Private::IELogArgDecoder Reader(Contents.data() + HeaderSize, static_cast<uint32_t>(Contents.size() - HeaderSize));
+        const char* const Body = Contents.data() + HeaderSize;
+        auto ReadString = [&Reader, Body](std::string& String) -> bool
+            {
+                uint64_t Length = 0;
+                if (Reader.ReadVarint(Length) && Reader.GetRemainingSize() >= Length)
+                {
+                    String.assign(Body + Reader.GetOffset(), static_cast<size_t>(Length));
+                    Reader.Skip(static_cast<uint32_t>(Length));
+                    return true;
+                }
+                return false;
+            };
+
+        auto ReadTimestamp = [&Reader, PreviousTimestampNs = int64_t(0)](int64_t& TimestampNs) mutable -> bool
+            {
+                uint64_t ZigzagDelta = 0;
+                if (Reader.ReadVarint(ZigzagDelta))
+                {
+                    PreviousTimestampNs += static_cast<int64_t>((ZigzagDelta >> 1) ^ (~(ZigzagDelta & 1) + 1));
+                    TimestampNs = PreviousTimestampNs;
+                    return true;
+                }
+                return false;
+            };
+
+        auto WriteLine = [Output](int64_t TimestampNs, int LogLevel, const std::string& Message, const std::string& FuncName)
+            {
+                static constexpr const char* LevelStrings[] = { "Error", "Log", "Success", "Warning" };
+                const int LevelIndex = std::clamp(LogLevel + 1, 0, 3);
+                const int64_t Seconds = TimestampNs / 1000000000;
+                const int64_t Microseconds = (TimestampNs % 1000000000) / 1000;
+                std::fprintf(Output, "[%lld.%06lld] IELog %s: %s [%s]\n", static_cast<long long>(Seconds), static_cast<long long>(Microseconds),
+                    LevelStrings[LevelIndex], Message.c_str(), FuncName.c_str());
+            };
+
+        uint8_t Kind = 0;
+        while (Reader.ReadByte(Kind))
+        {
+            bool bValidRecord = false;
+            switch (static_cast<Private::IELogBinaryRecordKind>(Kind))
+            {
+                case Private::IELogBinaryRecordKind::SiteDefinition:
+                {
+                    uint32_t SiteID = 0;
+                    uint8_t LogLevel = 0;
+                    DecodedSite Site;
+                    if (Reader.ReadRaw(&SiteID, sizeof(SiteID)) && Reader.ReadByte(LogLevel) && ReadString(Site.Format) && ReadString(Site.FuncName))
+                    {
+                        Site.LogLevel = static_cast<int8_t>(LogLevel);
+                        Sites[SiteID] = std::move(Site);
+                        bValidRecord = true;
+                    }
+                    break;
+                }
+                case Private::IELogBinaryRecordKind::Event:
+                {
+                    uint32_t SiteID = 0;
+                    int64_t TimestampNs = 0;
+                    std::string Payload;
+                    if (Reader.ReadRaw(&SiteID, sizeof(SiteID)) && ReadTimestamp(TimestampNs) && ReadString(Payload))
+                    {
+                        const std::unordered_map<uint32_t, DecodedSite>::const_iterator SiteIt = Sites.find(SiteID);
+                        if (SiteIt != Sites.end())
+                        {
+                            const std::string& Message = Private::FormatBinaryPayload(SiteIt->second.Format.c_str(), Payload.data(), static_cast<uint32_t>(Payload.size()));
+                            WriteLine(TimestampNs, SiteIt->second.LogLevel, Message, SiteIt->second.FuncName);
+                        }
+                        else
+                        {
+                            WriteLine(TimestampNs, 0, std::format("<unknown log site {:08x}>", SiteID), std::string());
+                        }
+                        bValidRecord = true;
+                    }
+                    break;
+                }
+                case Private::IELogBinaryRecordKind::Text:
+                {
+                    uint8_t LogLevel = 0;
+                    int64_t TimestampNs = 0;
+                    std::string FuncName;
+                    std::string Message;
+                    if (Reader.ReadByte(LogLevel) && ReadTimestamp(TimestampNs) && ReadString(FuncName) && ReadString(Message))
+                    {
+                        WriteLine(TimestampNs, static_cast<int8_t>(LogLevel), Message, FuncName);
+                        bValidRecord = true;
+                    }
+                    break;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+
+            if (!bValidRecord)
+            {
+                return IEResult(IEResult::Type::Fail, "Binary log is truncated or corrupted");
+            }
+        }
+
+        return IEResult(IEResult::Type::Success, "Decoded binary log");
+    }
+}
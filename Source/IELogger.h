@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IECommon.h"
+
+namespace IELogger
+{
+    /* Asynchronous Logging */
+
+    enum class OverflowPolicy : uint8_t
+    {
+        Drop,   // Producers never wait, records that do not fit are counted and discarded
+        Block   // Producers spin until the background writer frees a slot
+    };
+
+    struct AsyncConfig
+    {
+        uint32_t Capacity = 4096; // Rounded up to a power of two
+        OverflowPolicy Overflow = OverflowPolicy::Drop;
+        bool bFlushOnExit = true;
+        // std::terminate drains the ring into the sinks, SIGABRT only writes pending text records to stderr
+        bool bFlushOnAbort = true;
+    };
+
+    // Routes every IELOG_* call into a lock-free multi-producer ring buffer drained by a background writer thread.
+    IEResult StartAsync(const AsyncConfig& Config = AsyncConfig());
+    // Drains every pending record and joins the writer thread, logging becomes synchronous again.
+    void StopAsync();
+    bool IsAsync();
+
+    // Blocks until every record submitted before this call has been written.
+    void Flush();
+    uint64_t GetDroppedRecordCount();
+
+    /* Binary Logging */
+
+    // IELOG_* sites then only store their compile-time site ID and raw arguments, formatting is deferred to
+    // DecodeBinaryLog (or the IELogDecoder tool). An empty path writes to <IEConfigFolder>/Logs/<timestamp>.ielog.
+    IEResult StartBinary(const std::filesystem::path& Path = std::filesystem::path());
+    void StopBinary();
+    bool IsBinary();
+
+    IEResult DecodeBinaryLog(const std::filesystem::path& Path, FILE* Output);
+
+    /* Deduplication */
+
+    // Identical consecutive messages are folded into a single "repeated N times" record, enabled by default.
+    void SetDeduplicationEnabled(bool bEnabled);
+
+    /* Memory-mapped File Sink */
+
+    struct FileSinkConfig
+    {
+        std::string BaseName = "IECore";
+        std::filesystem::path Directory; // Defaults to <IEConfigFolder>/Logs
+        uint64_t MaxFileSize = 8 * 1024 * 1024; // Preallocated and mapped up front, the file rotates once full
+        uint32_t MaxFileCount = 5; // <BaseName>.log plus <BaseName>.1.log ... <BaseName>.<MaxFileCount - 1>.log
+        bool bMirrorToConsole = true;
+    };
+
+    // Text records are copied into a shared memory mapping of the current log file, the page cache flushes it
+    // and records written right before a crash are kept. Every start rotates the previous session's file.
+    IEResult StartFileSink(const FileSinkConfig& Config = FileSinkConfig());
+    void StopFileSink();
+    bool IsFileSinkOpen();
+}
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEProfiler.h"
+
+#include "IEUtils.h"
+
+namespace Private
+{
+    struct IEProfilerEvent
+    {
+        const char* Name = nullptr;
+        IEClock::time_point StartTime;
+        IEClock::time_point EndTime;
+    };
+
+    // Written only by its owning thread, Count is published with release so the capture can read [0, Count)
+    struct IEProfilerThreadBuffer
+    {
+        std::unique_ptr<IEProfilerEvent[]> Events;
+        uint32_t Capacity = 0;
+        uint32_t ThreadIndex = 0;
+        std::atomic<uint64_t> Generation = 0;
+        std::atomic<uint32_t> Count = 0;
+        std::atomic<uint64_t> DroppedCount = 0;
+        std::atomic<const char*> ThreadName = nullptr;
+    };
+
+    class IEProfilerSession
+    {
+    public:
+        IEResult Start(const std::filesystem::path& Path, const IEProfiler::CaptureConfig& Config)
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (bIEProfilerCapturing.load(std::memory_order_relaxed))
+            {
+                return IEResult(IEResult::Type::InvalidArgument, "A profiler capture is already running");
+            }
+
+            m_Path = Path;
+            m_EventsPerThread.store(std::max<uint32_t>(Config.EventsPerThread, 1), std::memory_order_relaxed);
+            m_StartTime = IEClock::now();
+            m_Generation.fetch_add(1, std::memory_order_release);
+            bIEProfilerCapturing.store(true, std::memory_order_release);
+            return IEResult(IEResult::Type::Success, "Started profiler capture");
+        }
+
+        IEExpected<std::filesystem::path> Stop()
+        {
+            std::lock_guard<std::mutex> Lock(m_Mutex);
+            if (!bIEProfilerCapturing.load(std::memory_order_relaxed))
+            {
+                return IEResult(IEResult::Type::InvalidArgument, "No profiler capture is running");
+            }
+
+            // Opened before the capture ends, on failure it keeps running with its events so StopCapture can be retried
+            std::error_code ErrorCode;
+            std::filesystem::create_directories(m_Path.parent_path(), ErrorCode);
+            FILE* const TraceFile = std::fopen(m_Path.string().c_str(), "wb");
+            if (!TraceFile)
+            {
+                return IEResult(IEResult::Type::Fail, "Failed to open trace file " + m_Path.string());
+            }
+            bIEProfilerCapturing.store(false, std::memory_order_release);
+
+            const uint64_t Generation = m_Generation.load(std::memory_order_relaxed);
+            uint64_t EventCount = 0;
+            uint64_t DroppedCount = 0;
+            bool bFirstEvent = true;
+            std::fprintf(TraceFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+            for (const std::shared_ptr<IEProfilerThreadBuffer>& ThreadBuffer : m_ThreadBuffers)
+            {
+                if (const char* const ThreadName = ThreadBuffer->ThreadName.load(std::memory_order_relaxed))
+                {
+                    std::fprintf(TraceFile, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", bFirstEvent ? "" : ",", ThreadBuffer->ThreadIndex);
+                    WriteJsonString(TraceFile, ThreadName);
+                    std::fprintf(TraceFile, "}}");
+                    bFirstEvent = false;
+                }
+
+                if (ThreadBuffer->Generation.load(std::memory_order_acquire) != Generation)
+                {
+                    continue;
+                }
+
+                const uint32_t Count = ThreadBuffer->Count.load(std::memory_order_acquire);
+                for (uint32_t EventIndex = 0; EventIndex < Count; EventIndex++)
+                {
+                    const IEProfilerEvent& Event = ThreadBuffer->Events[EventIndex];
+                    std::fprintf(TraceFile, "%s\n{\"name\":", bFirstEvent ? "" : ",");
+                    WriteJsonString(TraceFile, Event.Name);
+                    std::fprintf(TraceFile, ",\"cat\":\"IECore\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", ThreadBuffer->ThreadIndex,
+                        std::chrono::duration<double, std::micro>(Event.StartTime - m_StartTime).count(),
+                        std::chrono::duration<double, std::micro>(Event.EndTime - Event.StartTime).count());
+                    bFirstEvent = false;
+                }
+                EventCount += Count;
+                DroppedCount += ThreadBuffer->DroppedCount.exchange(0, std::memory_order_relaxed);
+            }
+            std::fprintf(TraceFile, "\n]}\n");
+            std::fclose(TraceFile);
+
+            if (DroppedCount > 0)
+            {
+                IELOG_WARNING("Profiler capture dropped %llu events, raise CaptureConfig::EventsPerThread", static_cast<unsigned long long>(DroppedCount));
+            }
+            IELOG_INFO("Wrote %llu profiler events to %s", static_cast<unsigned long long>(EventCount), m_Path.string().c_str());
+            return m_Path;
+        }
+
+        void Record(const char* Name, IEClock::time_point StartTime, IEClock::time_point EndTime)
+        {
+            IEProfilerThreadBuffer& ThreadBuffer = GetThreadBuffer();
+
+            // The first event of a thread in a new capture rewinds its buffer, Stop() of the previous one has already returned
+            const uint64_t Generation = m_Generation.load(std::memory_order_acquire);
+            if (ThreadBuffer.Generation.load(std::memory_order_relaxed) != Generation)
+            {
+                const uint32_t EventsPerThread = m_EventsPerThread.load(std::memory_order_relaxed);
+                if (ThreadBuffer.Capacity != EventsPerThread)
+                {
+                    ThreadBuffer.Events = std::make_unique<IEProfilerEvent[]>(EventsPerThread);
+                    ThreadBuffer.Capacity = EventsPerThread;
+                }
+                ThreadBuffer.Count.store(0, std::memory_order_relaxed);
+                ThreadBuffer.DroppedCount.store(0, std::memory_order_relaxed);
+                ThreadBuffer.Generation.store(Generation, std::memory_order_release);
+            }
+
+            const uint32_t Count = ThreadBuffer.Count.load(std::memory_order_relaxed);
+            if (Count < ThreadBuffer.Capacity)
+            {
+                ThreadBuffer.Events[Count] = IEProfilerEvent{ Name, StartTime, EndTime };
+                ThreadBuffer.Count.store(Count + 1, std::memory_order_release);
+            }
+            else
+            {
+                ThreadBuffer.DroppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        IEProfilerThreadBuffer& GetThreadBuffer()
+        {
+            // Registration takes the lock once per thread, every later event only touches the thread's own buffer
+            thread_local std::shared_ptr<IEProfilerThreadBuffer> ThreadBuffer;
+            if (!ThreadBuffer)
+            {
+                ThreadBuffer = std::make_shared<IEProfilerThreadBuffer>();
+                std::lock_guard<std::mutex> Lock(m_Mutex);
+                ThreadBuffer->ThreadIndex = static_cast<uint32_t>(m_ThreadBuffers.size());
+                m_ThreadBuffers.push_back(ThreadBuffer);
+            }
+            return *ThreadBuffer;
+        }
+
+    private:
+        static void WriteJsonString(FILE* File, const char* String)
+        {
+            std::fputc('"', File);
+            for (const char* Character = String ? String : ""; *Character; Character++)
+            {
+                if (*Character == '"' || *Character == '\\')
+                {
+                    std::fputc('\\', File);
+                    std::fputc(*Character, File);
+                }
+                else if (static_cast<unsigned char>(*Character) < 0x20)
+                {
+                    std::fprintf(File, "\\u%04x", static_cast<unsigned int>(*Character));
+                }
+                else
+                {
+                    std::fputc(*Character, File);
+                }
+            }
+            std::fputc('"', File);
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::vector<std::shared_ptr<IEProfilerThreadBuffer>> m_ThreadBuffers;
+        std::atomic<uint64_t> m_Generation = 0;
+        std::atomic<uint32_t> m_EventsPerThread = 0;
+        IEClock::time_point m_StartTime;
+        std::filesystem::path m_Path;
+    };
+
+    static IEProfilerSession& GetProfilerSession()
+    {
+        static IEProfilerSession ProfilerSession;
+        return ProfilerSession;
+    }
+
+    void IEProfilerRecordEvent(const char* Name, IEClock::time_point StartTime, IEClock::time_point EndTime)
+    {
+        GetProfilerSession().Record(Name, StartTime, EndTime);
+    }
+}
+
+namespace IEProfiler
+{
+    IEResult StartCapture(const std::filesystem::path& Path, const CaptureConfig& Config)
+    {
+        std::filesystem::path TracePath = Path;
+        if (TracePath.empty())
+        {
+            const int64_t TimestampSeconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            TracePath = IEUtils::GetIEConfigFolderPath() / "Traces" / std::format("{}.json", TimestampSeconds);
+        }
+        return Private::GetProfilerSession().Start(TracePath, Config);
+    }
+
+    IEExpected<std::filesystem::path> StopCapture()
+    {
+        return Private::GetProfilerSession().Stop();
+    }
+
+    bool IsCapturing()
+    {
+        return Private::bIEProfilerCapturing.load(std::memory_order_relaxed);
+    }
+
+    void SetCurrentThreadName(const char* Name)
+    {
+        Private::GetProfilerSession().GetThreadBuffer().ThreadName.store(Name, std::memory_order_relaxed);
+    }
+}
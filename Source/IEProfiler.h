@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IECommon.h"
+
+#ifndef ENABLE_IE_PROFILER
+#define ENABLE_IE_PROFILER true
+#endif
+
+namespace IEProfiler
+{
+    /* Capture */
+
+    struct CaptureConfig
+    {
+        uint32_t EventsPerThread = 1 << 16; // Events past this are counted and dropped
+    };
+
+    // Scopes are recorded from StartCapture until StopCapture, which writes them as Chrome trace-event JSON
+    // (chrome://tracing, ui.perfetto.dev). An empty path writes to <IEConfigFolder>/Traces/<timestamp>.json.
+    // If the trace file cannot be opened the capture keeps running, so StopCapture can be retried.
+    IEResult StartCapture(const std::filesystem::path& Path = std::filesystem::path(), const CaptureConfig& Config = CaptureConfig());
+    IEExpected<std::filesystem::path> StopCapture();
+    bool IsCapturing();
+
+    // Shown as the thread name in the trace viewer, Name must outlive the capture.
+    void SetCurrentThreadName(const char* Name);
+}
+
+namespace Private
+{
+    inline std::atomic<bool> bIEProfilerCapturing = false;
+
+    // Name must be a string with static storage duration, only the pointer is stored.
+    void IEProfilerRecordEvent(const char* Name, IEClock::time_point StartTime, IEClock::time_point EndTime);
+
+    class IEProfilerScopedEvent
+    {
+    public:
+        explicit IEProfilerScopedEvent(const char* _Name)
+            : m_Name(_Name), m_bRecording(bIEProfilerCapturing.load(std::memory_order_relaxed))
+        {
+            if (m_bRecording)
+            {
+                m_StartTime = IEClock::now();
+            }
+        }
+
+        ~IEProfilerScopedEvent()
+        {
+            if (m_bRecording)
+            {
+                IEProfilerRecordEvent(m_Name, m_StartTime, IEClock::now());
+            }
+        }
+
+        IEProfilerScopedEvent(const IEProfilerScopedEvent&) = delete;
+        IEProfilerScopedEvent& operator=(const IEProfilerScopedEvent&) = delete;
+
+    private:
+        const char* m_Name = nullptr;
+        bool m_bRecording = false;
+        IEClock::time_point m_StartTime;
+    };
+}
+
+#define IE_PROFILE_CONCAT_IMPL(A, B) A##B
+#define IE_PROFILE_CONCAT(A, B) IE_PROFILE_CONCAT_IMPL(A, B)
+
+#if ENABLE_IE_PROFILER
+    // Records the enclosing scope as a complete event while a capture is running, costs one relaxed load otherwise.
+    #define IE_PROFILE_SCOPE(Name) const Private::IEProfilerScopedEvent IE_PROFILE_CONCAT(IEProfileScope, __LINE__)(Name)
+    #define IE_PROFILE_FUNCTION() IE_PROFILE_SCOPE(__func__)
+#else
+    #define IE_PROFILE_SCOPE(Name) do {} while (0)
+    #define IE_PROFILE_FUNCTION() do {} while (0)
+#endif
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IERefreshGovernor.h"
+
+const char* GetIERefreshStateName(IERefreshState State)
+{
+    switch (State)
+    {
+    case IERefreshState::Interactive: return "Interactive";
+    case IERefreshState::Animating: return "Animating";
+    case IERefreshState::Idle: return "Idle";
+    case IERefreshState::Occluded: return "Occluded";
+    }
+    return "Unknown";
+}
+
+IERefreshDecision IEAdaptiveRefreshGovernor::Evaluate(const IERefreshActivity& Activity)
+{
+    IERefreshDecision Decision;
+    const std::chrono::nanoseconds ActiveFrameDuration = std::max(Activity.DisplayFrameDuration, m_Config.MinFrameDuration);
+    const IEClock::time_point LastActivityTime = std::max(Activity.LastInputTime, Activity.LastActivityHintTime);
+    if (Activity.bOccluded)
+    {
+        Decision.State = IERefreshState::Occluded;
+        Decision.FrameDuration = std::chrono::nanoseconds::zero();
+    }
+    else if (Activity.CurrentTime - LastActivityTime < m_Config.InteractiveHoldDuration)
+    {
+        Decision.State = IERefreshState::Interactive;
+        Decision.FrameDuration = ActiveFrameDuration;
+    }
+    else if (Activity.bAnimating)
+    {
+        Decision.State = IERefreshState::Animating;
+        Decision.FrameDuration = ActiveFrameDuration;
+    }
+    else
+    {
+        Decision.State = IERefreshState::Idle;
+        Decision.FrameDuration = m_Config.IdleFrameDuration;
+    }
+    return Decision;
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include "IECommon.h"
+
+enum class IERefreshState : uint8_t
+{
+    Interactive, // Input or activity hints arrived recently
+    Animating,   // A scheduled animation is running
+    Idle,        // Nothing is changing, frames are drawn at a low rate
+    Occluded     // Nothing is visible, no frames are drawn
+};
+
+const char* GetIERefreshStateName(IERefreshState State);
+
+struct IERefreshActivity
+{
+    IEClock::time_point CurrentTime;
+    IEClock::time_point LastInputTime;
+    IEClock::time_point LastActivityHintTime;
+    std::chrono::nanoseconds DisplayFrameDuration{};
+    bool bAnimating = false;
+    bool bOccluded = false;
+};
+
+struct IERefreshDecision
+{
+    IERefreshState State = IERefreshState::Interactive;
+    // Interactive and Animating frames are paced at this interval, Idle waits at most this long for events.
+    std::chrono::nanoseconds FrameDuration{};
+};
+
+// Picks the frame rate of the app loop from recent UI activity, evaluated once per IERenderer::WaitForNextRedraw.
+class IERefreshGovernor
+{
+public:
+    virtual ~IERefreshGovernor() = default;
+
+public:
+    virtual IERefreshDecision Evaluate(const IERefreshActivity& Activity) = 0;
+    virtual const char* GetName() const = 0;
+};
+
+// Full display refresh rate while interacting or animating, a low rate once idle and no frames at all while occluded.
+class IEAdaptiveRefreshGovernor : public IERefreshGovernor
+{
+public:
+    struct Config
+    {
+        std::chrono::nanoseconds InteractiveHoldDuration = std::chrono::seconds(1); // Stays interactive this long after the last input
+        std::chrono::nanoseconds IdleFrameDuration = std::chrono::seconds(1); // Zero only redraws on events and scheduled redraws
+        std::chrono::nanoseconds MinFrameDuration{}; // Caps the interactive rate below the display refresh rate when non zero
+    };
+
+public:
+    IEAdaptiveRefreshGovernor() = default;
+    explicit IEAdaptiveRefreshGovernor(const Config& _Config) : m_Config(_Config) {}
+
+public:
+    /* Begin IERefreshGovernor Implementation */
+    IERefreshDecision Evaluate(const IERefreshActivity& Activity) override;
+    const char* GetName() const override { return "Adaptive"; }
+    /* End IERefreshGovernor Implementation */
+
+private:
+    Config m_Config;
+};
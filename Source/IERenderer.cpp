@@ -23,6 +23,25 @@ extern void ShowRunningInBackgroundLinuxNotification(const IERenderer* Renderer)
 #define OS_SUPPORT_RUN_IN_BACKGROUND 0
 #endif
 
+/* Vulkan Extension Negotiation */
+// Instance extensions required by GLFW for the platform surface are added at runtime
+static constexpr std::array<const char*, 2> OptionalInstanceExtensions = { VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME };
+static constexpr std::array<const char*, 1> RequiredDeviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+// VK_KHR_portability_subset must be enabled whenever a device exposes it, its name macro only lives in the beta header
+static constexpr std::array<const char*, 2> OptionalDeviceExtensions = { VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, "VK_KHR_portability_subset" };
+
+const char* GetIELatencyModeName(IELatencyMode LatencyMode)
+{
+    switch (LatencyMode)
+    {
+    case IELatencyMode::PowerSaving: return "Power Saving";
+    case IELatencyMode::Balanced: return "Balanced";
+    case IELatencyMode::LowLatency: return "Low Latency";
+    case IELatencyMode::Uncapped: return "Uncapped";
+    default: return "Unknown";
+    }
+}
+
 void IERenderer::PostWindowCreated()
 {
     glfwSetWindowUserPointer(m_AppWindow, this);
@@ -31,7 +50,7 @@ void IERenderer::PostWindowCreated()
         {
             glfwPostEmptyEvent();
         });
-    
+
     glfwSetWindowCloseCallback(m_AppWindow, [](GLFWwindow* Window)
         {
             if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
@@ -40,10 +59,69 @@ void IERenderer::PostWindowCreated()
             }
         });
 
+    // The input layer owns these callbacks, ImGui is initialized without its own and receives coalesced events once per frame
+    glfwSetWindowFocusCallback(m_AppWindow, [](GLFWwindow* Window, int Focused)
+        {
+            if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
+            {
+                Renderer->m_bAppWindowFocused = Focused == GLFW_TRUE;
+                Renderer->OnInputEvent({ .Type = IEInputEventType::Focus, .Code = Focused });
+            }
+        });
+
+    glfwSetCursorEnterCallback(m_AppWindow, [](GLFWwindow* Window, int Entered)
+        {
+            if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
+            {
+                Renderer->OnInputEvent({ .Type = IEInputEventType::CursorEnter, .Code = Entered });
+            }
+        });
+
+    glfwSetCursorPosCallback(m_AppWindow, [](GLFWwindow* Window, double X, double Y)
+        {
+            if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
+            {
+                Renderer->OnInputEvent({ .Type = IEInputEventType::CursorPos, .X = X, .Y = Y });
+            }
+        });
+
+    glfwSetMouseButtonCallback(m_AppWindow, [](GLFWwindow* Window, int Button, int Action, int Mods)
+        {
+            if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
+            {
+                Renderer->OnInputEvent({ .Type = IEInputEventType::MouseButton, .Code = Button, .Action = Action, .Mods = Mods });
+            }
+        });
+
+    glfwSetScrollCallback(m_AppWindow, [](GLFWwindow* Window, double OffsetX, double OffsetY)
+        {
+            if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
+            {
+                Renderer->OnInputEvent({ .Type = IEInputEventType::Scroll, .X = OffsetX, .Y = OffsetY });
+            }
+        });
+
+    glfwSetKeyCallback(m_AppWindow, [](GLFWwindow* Window, int Key, int ScanCode, int Action, int Mods)
+        {
+            if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
+            {
+                Renderer->OnInputEvent({ .Type = IEInputEventType::Key, .Code = Key, .ScanCode = ScanCode, .Action = Action, .Mods = Mods });
+            }
+        });
+
+    glfwSetCharCallback(m_AppWindow, [](GLFWwindow* Window, unsigned int Codepoint)
+        {
+            if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
+            {
+                Renderer->OnInputEvent({ .Type = IEInputEventType::Char, .Code = static_cast<int32_t>(Codepoint) });
+            }
+        });
+
     glfwSetWindowIconifyCallback(m_AppWindow, [](GLFWwindow* Window, int Iconified)
         {
             if (IERenderer* const Renderer = reinterpret_cast<IERenderer*>(glfwGetWindowUserPointer(Window)))
             {
+                Renderer->m_bAppWindowIconified = Iconified == GLFW_TRUE;
                 if (Iconified)
                 {
                     Renderer->OnAppWindowMinimizeRequested();
@@ -67,7 +145,7 @@ void IERenderer::PostWindowCreated()
     }
     else
     {
-        IELOG_ERROR(stbi_failure_reason());
+        IELOG_CATEGORY_ERROR(Renderer, "%s", stbi_failure_reason());
     }
 
     InitializeOSApp();
@@ -98,6 +176,318 @@ void IERenderer::PostEmptyEvent() const
     glfwPostEmptyEvent();
 }
 
+void IERenderer::RequestRedrawAt(IEClock::time_point Deadline)
+{
+    bool bIsEarliestDeadline = false;
+    {
+        std::lock_guard<std::mutex> Lock(m_RedrawScheduleMutex);
+        bIsEarliestDeadline = m_RedrawDeadlines.empty() || Deadline < m_RedrawDeadlines.top();
+        m_RedrawDeadlines.push(Deadline);
+    }
+
+    if (bIsEarliestDeadline && m_AppWindow)
+    {
+        PostEmptyEvent();
+    }
+}
+
+void IERenderer::RequestAnimationFor(std::chrono::nanoseconds Duration)
+{
+    bool bWasIdle = false;
+    {
+        std::lock_guard<std::mutex> Lock(m_RedrawScheduleMutex);
+        const IEClock::time_point AnimateUntil = IEClock::now() + Duration;
+        bWasIdle = m_AnimateUntil < IEClock::now();
+        m_AnimateUntil = std::max(m_AnimateUntil, AnimateUntil);
+    }
+
+    if (bWasIdle && m_AppWindow)
+    {
+        PostEmptyEvent();
+    }
+}
+
+bool IERenderer::WaitForNextRedraw()
+{
+    static constexpr uint32_t SettleFrameCount = 2;
+
+    std::optional<IEClock::time_point> NextDeadline;
+    bool bShouldPoll = false;
+    bool bAnimating = false;
+    {
+        std::lock_guard<std::mutex> Lock(m_RedrawScheduleMutex);
+        const IEClock::time_point CurrentTime = IEClock::now();
+        bool bDeadlineReached = false;
+        while (!m_RedrawDeadlines.empty() && m_RedrawDeadlines.top() <= CurrentTime)
+        {
+            m_RedrawDeadlines.pop();
+            bDeadlineReached = true;
+        }
+
+        if (!m_RedrawDeadlines.empty())
+        {
+            NextDeadline = m_RedrawDeadlines.top();
+        }
+
+        if (m_SettleFrameCount > 0)
+        {
+            m_SettleFrameCount--;
+            bShouldPoll = true;
+        }
+        bAnimating = CurrentTime < m_AnimateUntil;
+        bShouldPoll = bShouldPoll || bDeadlineReached;
+    }
+
+    // Replays drive frames back to back like an animation
+    UpdateRefreshDecision(bAnimating || m_InputLayer.IsReplaying());
+    std::optional<IEClock::time_point> FrameDeadline;
+    switch (m_RefreshDecision.State)
+    {
+    case IERefreshState::Interactive:
+    case IERefreshState::Animating:
+        bShouldPoll = true;
+        if (m_RefreshDecision.FrameDuration > std::chrono::nanoseconds::zero())
+        {
+            // Applies the governor rate here too, apps driving the renderer without IEApp's frame pacer get it as well
+            FrameDeadline = m_LastRedrawTime + m_RefreshDecision.FrameDuration;
+        }
+        break;
+    case IERefreshState::Idle:
+        if (m_RefreshDecision.FrameDuration > std::chrono::nanoseconds::zero())
+        {
+            const IEClock::time_point IdleDeadline = m_LastRedrawTime + m_RefreshDecision.FrameDuration;
+            NextDeadline = NextDeadline.has_value() ? std::min(NextDeadline.value(), IdleDeadline) : IdleDeadline;
+        }
+        break;
+    case IERefreshState::Occluded:
+        // Return right away, AdmitFrame then routes the loop to WaitForBackgroundTick
+        bShouldPoll = true;
+        break;
+    }
+
+    bool bBlocked = false;
+    if (bShouldPoll)
+    {
+        // Sleeps instead of waiting on events, input arriving early must not redraw above the governor rate
+        if (FrameDeadline.has_value() && FrameDeadline.value() > IEClock::now())
+        {
+            std::this_thread::sleep_until(FrameDeadline.value());
+        }
+        PollEvents();
+    }
+    else
+    {
+        if (NextDeadline.has_value())
+        {
+            // glfwWaitEventsTimeout rejects non positive timeouts
+            const double Timeout = std::chrono::duration<double>(NextDeadline.value() - IEClock::now()).count();
+            if (Timeout > 0.0)
+            {
+                WaitEventsTimeout(Timeout);
+            }
+            else
+            {
+                PollEvents();
+            }
+        }
+        else
+        {
+            WaitEvents();
+        }
+        bBlocked = true;
+
+        std::lock_guard<std::mutex> Lock(m_RedrawScheduleMutex);
+        m_SettleFrameCount = SettleFrameCount;
+    }
+    m_LastRedrawTime = IEClock::now();
+    return bBlocked;
+}
+
+void IERenderer::SetRefreshGovernor(std::unique_ptr<IERefreshGovernor> Governor)
+{
+    if (Governor)
+    {
+        m_RefreshGovernor = std::move(Governor);
+    }
+}
+
+void IERenderer::NotifyUIActivity()
+{
+    m_LastActivityHintTicks.store(IEClock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds IERenderer::GetDisplayFrameDuration() const
+{
+    std::chrono::nanoseconds DisplayFrameDuration = std::chrono::milliseconds(TARGET_FRAME_DURATION);
+    GLFWmonitor* Monitor = m_AppWindow ? glfwGetWindowMonitor(m_AppWindow) : nullptr;
+    if (!Monitor)
+    {
+        Monitor = glfwGetPrimaryMonitor();
+    }
+
+    if (Monitor)
+    {
+        if (const GLFWvidmode* const VideoMode = glfwGetVideoMode(Monitor))
+        {
+            if (VideoMode->refreshRate > 0)
+            {
+                DisplayFrameDuration = std::chrono::nanoseconds(1'000'000'000 / VideoMode->refreshRate);
+            }
+        }
+    }
+    return DisplayFrameDuration;
+}
+
+void IERenderer::OnInputEvent(IEInputEvent Event)
+{
+    const int64_t CurrentTicks = IEClock::now().time_since_epoch().count();
+    Event.TimestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(IEClock::duration(CurrentTicks)).count();
+    m_InputLayer.PushEvent(Event);
+    if (Event.Type != IEInputEventType::Focus)
+    {
+        m_LastInputTicks.store(CurrentTicks, std::memory_order_relaxed);
+    }
+}
+
+IEResult IERenderer::StartInputRecording(const std::filesystem::path& Path)
+{
+    return m_InputLayer.StartRecording(Path);
+}
+
+void IERenderer::StopInputRecording()
+{
+    m_InputLayer.StopRecording();
+}
+
+IEResult IERenderer::StartInputReplay(const std::filesystem::path& Path, std::chrono::nanoseconds FixedDeltaTime)
+{
+    IEResult Result = m_InputLayer.StartReplay(Path);
+    if (Result.Type == IEResult::Type::Success)
+    {
+        m_ReplayDeltaTime = FixedDeltaTime;
+        if (m_ReplayTimingsFile)
+        {
+            std::fclose(m_ReplayTimingsFile);
+        }
+
+        std::filesystem::path TimingsPath = Path;
+        TimingsPath += ".timings.csv";
+        if ((m_ReplayTimingsFile = std::fopen(TimingsPath.string().c_str(), "w")))
+        {
+            std::fprintf(m_ReplayTimingsFile, "Frame");
+            for (uint32_t StageIndex = 0; StageIndex < IEFrameProfiler::StageCount; StageIndex++)
+            {
+                std::fprintf(m_ReplayTimingsFile, ",%s", GetIEFrameStageName(static_cast<IEFrameStage>(StageIndex)));
+            }
+            std::fprintf(m_ReplayTimingsFile, ",TotalCPU,GPU\n");
+        }
+        else
+        {
+            IELOG_CATEGORY_WARNING(Frame, "Failed to open replay timings file %s", TimingsPath.string().c_str());
+        }
+    }
+    return Result;
+}
+
+void IERenderer::OnFrameEnded()
+{
+    if (m_ReplayTimingsFile)
+    {
+        std::fprintf(m_ReplayTimingsFile, "%llu", static_cast<unsigned long long>(m_InputLayer.GetFrameIndex()));
+        for (uint32_t StageIndex = 0; StageIndex < IEFrameProfiler::StageCount; StageIndex++)
+        {
+            std::fprintf(m_ReplayTimingsFile, ",%.4f", m_FrameProfiler.GetLastStageDurationMs(static_cast<IEFrameStage>(StageIndex)));
+        }
+        std::fprintf(m_ReplayTimingsFile, ",%.4f,%.4f\n", m_FrameProfiler.GetLastTotalDurationMs(), m_FrameProfiler.GetLastGPUFrameDurationMs());
+
+        if (!m_InputLayer.IsReplaying())
+        {
+            std::fclose(m_ReplayTimingsFile);
+            m_ReplayTimingsFile = nullptr;
+
+            const IEFrameProfiler::StageStatistics TotalStatistics = m_FrameProfiler.ComputeTotalStatistics();
+            IELOG_CATEGORY_INFO(Frame, "Replay CPU frame time p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms",
+                TotalStatistics.P50Ms, TotalStatistics.P95Ms, TotalStatistics.P99Ms, TotalStatistics.MaxMs);
+        }
+    }
+}
+
+void IERenderer::UpdateRefreshDecision(bool bAnimating)
+{
+    IERefreshActivity Activity;
+    Activity.CurrentTime = IEClock::now();
+    Activity.LastInputTime = IEClock::time_point(IEClock::duration(m_LastInputTicks.load(std::memory_order_relaxed)));
+    Activity.LastActivityHintTime = IEClock::time_point(IEClock::duration(m_LastActivityHintTicks.load(std::memory_order_relaxed)));
+    Activity.DisplayFrameDuration = GetDisplayFrameDuration();
+    Activity.bAnimating = bAnimating;
+    Activity.bOccluded = !m_AppWindow || IsAppWindowMinimized() || !glfwGetWindowAttrib(m_AppWindow, GLFW_VISIBLE);
+
+    const IERefreshState PreviousState = m_RefreshDecision.State;
+    m_RefreshDecision = m_RefreshGovernor->Evaluate(Activity);
+    if (m_RefreshDecision.State != PreviousState)
+    {
+        IELOG_CATEGORY_INFO(Frame, "Refresh state %s -> %s", GetIERefreshStateName(PreviousState), GetIERefreshStateName(m_RefreshDecision.State));
+    }
+}
+
+bool IERenderer::AdmitFrame()
+{
+    bool bAdmitFrame = false;
+    if (IsAppWindowOpen() && !m_bAppWindowIconified && glfwGetWindowAttrib(m_AppWindow, GLFW_VISIBLE))
+    {
+        int FrameBufferWidth = 0, FrameBufferHeight = 0;
+        glfwGetFramebufferSize(m_AppWindow, &FrameBufferWidth, &FrameBufferHeight);
+        bAdmitFrame = FrameBufferWidth > 0 && FrameBufferHeight > 0;
+    }
+
+    if (bAdmitFrame != m_bFrameAdmitted)
+    {
+        IELOG_CATEGORY_INFO(Frame, "%s UI frames", bAdmitFrame ? "Resuming" : "Suspending");
+        m_bFrameAdmitted = bAdmitFrame;
+        InvalidatePresentedDrawData();
+    }
+    return bAdmitFrame;
+}
+
+void IERenderer::AddBackgroundTickCallbackFunc(std::chrono::nanoseconds Interval, const IEBackgroundTickFunc& Func)
+{
+    m_BackgroundTicks.push_back({ std::max(Interval, std::chrono::nanoseconds(std::chrono::milliseconds(1))), IEClock::now() + Interval, Func });
+}
+
+void IERenderer::WaitForBackgroundTick()
+{
+    IEClock::time_point CurrentTime = IEClock::now();
+    std::optional<IEClock::time_point> NextTickTime;
+    for (BackgroundTick& Tick : m_BackgroundTicks)
+    {
+        if (CurrentTime >= Tick.NextTickTime)
+        {
+            Tick.Func();
+            CurrentTime = IEClock::now();
+            // Ticks missed while blocked are dropped rather than run back to back
+            Tick.NextTickTime = std::max(Tick.NextTickTime + Tick.Interval, CurrentTime);
+        }
+        NextTickTime = NextTickTime.has_value() ? std::min(NextTickTime.value(), Tick.NextTickTime) : Tick.NextTickTime;
+    }
+
+    if (NextTickTime.has_value())
+    {
+        const double Timeout = std::chrono::duration<double>(NextTickTime.value() - IEClock::now()).count();
+        if (Timeout > 0.0)
+        {
+            WaitEventsTimeout(Timeout);
+        }
+        else
+        {
+            PollEvents();
+        }
+    }
+    else
+    {
+        WaitEvents();
+    }
+}
+
 bool IERenderer::IsAppRunning() const
 {
     return !m_ExitRequested;
@@ -157,6 +547,10 @@ void IERenderer::CloseAppWindow()
             glfwHideWindow(m_AppWindow);
             NotifyOSRunInBackground();
             BroadcastOnWindowClosed();
+            if (m_bBackgroundTrimEnabled)
+            {
+                ReleaseWindowResources();
+            }
         }
         else
         {
@@ -173,10 +567,15 @@ void IERenderer::MinimizeAppWindow() const
     }
 }
 
-void IERenderer::RestoreAppWindow() const
+void IERenderer::RestoreAppWindow()
 {
     if (m_AppWindow)
     {
+        // Stays hidden in the background without a swapchain, the next restore request retries
+        if (m_bBackgroundTrimEnabled && !RestoreWindowResources())
+        {
+            return;
+        }
         glfwSetWindowShouldClose(m_AppWindow, GLFW_FALSE);
         glfwShowWindow(m_AppWindow);
         glfwRestoreWindow(m_AppWindow);
@@ -234,12 +633,161 @@ void IERenderer::DrawTelemetry() const
                                     ImGuiWindowFlags_NoMouseInputs;
 
     ImGuiViewport& MainViewport = *ImGui::GetMainViewport();
-    ImGui::SetNextWindowPos(ImVec2(MainViewport.Pos.x, MainViewport.Pos.y + MainViewport.Size.y - ImGui::GetFrameHeightWithSpacing() - ImGui::GetStyle().WindowPadding.y));
+    if (m_bDetailedTelemetryVisible)
+    {
+        TelemetryWindowFlags |= ImGuiWindowFlags_AlwaysAutoResize;
+        ImGui::SetNextWindowPos(ImVec2(MainViewport.Pos.x, MainViewport.Pos.y + MainViewport.Size.y), ImGuiCond_Always, ImVec2(0.0f, 1.0f));
+    }
+    else
+    {
+        ImGui::SetNextWindowPos(ImVec2(MainViewport.Pos.x, MainViewport.Pos.y + MainViewport.Size.y - ImGui::GetFrameHeightWithSpacing() - ImGui::GetStyle().WindowPadding.y));
+    }
+    const IEClock::time_point CurrentTime = IEClock::now();
+    if (!m_bDamageTrackingEnabled || CurrentTime - m_TelemetrySample.Time >= std::chrono::milliseconds(500))
+    {
+        m_TelemetrySample.Time = CurrentTime;
+        m_TelemetrySample.Framerate = IO.Framerate;
+        m_TelemetrySample.RenderedFrameCount = m_RenderedFrameCount;
+        m_TelemetrySample.SkippedFrameCount = m_SkippedFrameCount;
+    }
+
     ImGui::Begin("Telemetry", nullptr, TelemetryWindowFlags);
-    ImGui::Text("Frame Duration (ms): %.2f | FPS: %.0f", 1000.0f / IO.Framerate, IO.Framerate);
+    ImGui::Text("Frame Duration (ms): %.2f | FPS: %.0f", 1000.0f / m_TelemetrySample.Framerate, m_TelemetrySample.Framerate);
+    ImGui::SameLine();
+    ImGui::Text("| Refresh: %s (%s)", GetIERefreshStateName(m_RefreshDecision.State), m_RefreshGovernor->GetName());
+    if (m_bDamageTrackingEnabled)
+    {
+        ImGui::SameLine();
+        ImGui::Text("| Rendered: %llu | Skipped: %llu", static_cast<unsigned long long>(m_TelemetrySample.RenderedFrameCount),
+            static_cast<unsigned long long>(m_TelemetrySample.SkippedFrameCount));
+    }
+    if (m_bDetailedTelemetryVisible)
+    {
+        DrawFrameProfilerTelemetry();
+    }
     ImGui::End();
 }
 
+void IERenderer::DrawFrameProfilerTelemetry() const
+{
+    const float PlotHeight = ImGui::GetTextLineHeight() * 2.0f;
+    const ImVec2 PlotSize = ImVec2(ImGui::CalcTextSize("0").x * 32.0f, PlotHeight);
+
+    ImGui::Text("%-14s %7s %7s %7s %7s (ms)", "Stage", "p50", "p95", "p99", "max");
+    for (uint32_t StageIndex = 0; StageIndex < IEFrameProfiler::StageCount; StageIndex++)
+    {
+        const IEFrameStage Stage = static_cast<IEFrameStage>(StageIndex);
+        const IEFrameProfiler::StageStatistics Statistics = m_FrameProfiler.ComputeStageStatistics(Stage);
+        ImGui::Text("%-14s %7.3f %7.3f %7.3f %7.3f", GetIEFrameStageName(Stage), Statistics.P50Ms, Statistics.P95Ms, Statistics.P99Ms, Statistics.MaxMs);
+        ImGui::SameLine();
+        ImGui::PushID(static_cast<int>(StageIndex));
+        ImGui::PlotLines("", m_FrameProfiler.GetStageHistory(Stage), static_cast<int>(m_FrameProfiler.GetHistoryCount()),
+            static_cast<int>(m_FrameProfiler.GetHistoryOffset()), nullptr, 0.0f, std::max(Statistics.MaxMs, 0.001f), ImVec2(PlotSize.x, ImGui::GetTextLineHeight()));
+        ImGui::PopID();
+    }
+
+    const IEInputLayer::Statistics& InputStatistics = m_InputLayer.GetStatistics();
+    ImGui::Text("Input Events: %u received, %u dispatched", InputStatistics.ReceivedEventCount, InputStatistics.DispatchedEventCount);
+    ImGui::Text("Latency Mode: %s | Frames In Flight: %u | Render Thread: %s", GetIELatencyModeName(GetLatencyMode()), GetFramesInFlight(),
+        IsRenderThreadEnabled() ? "On" : "Off");
+
+    const IEFrameProfiler::StageStatistics TotalStatistics = m_FrameProfiler.ComputeTotalStatistics();
+    ImGui::Text("%-14s %7.3f %7.3f %7.3f %7.3f", "Total CPU", TotalStatistics.P50Ms, TotalStatistics.P95Ms, TotalStatistics.P99Ms, TotalStatistics.MaxMs);
+    ImGui::PlotLines("##TotalCPU", m_FrameProfiler.GetTotalHistory(), static_cast<int>(m_FrameProfiler.GetHistoryCount()),
+        static_cast<int>(m_FrameProfiler.GetHistoryOffset()), nullptr, 0.0f, std::max(TotalStatistics.MaxMs, 0.001f), ImVec2(PlotSize.x * 2.0f, PlotHeight));
+
+    if (m_FrameProfiler.HasGPUTimings())
+    {
+        const IEFrameProfiler::StageStatistics GPUStatistics = m_FrameProfiler.ComputeGPUStatistics();
+        ImGui::Text("%-14s %7.3f %7.3f %7.3f %7.3f", "GPU Render", GPUStatistics.P50Ms, GPUStatistics.P95Ms, GPUStatistics.P99Ms, GPUStatistics.MaxMs);
+        ImGui::PlotLines("##GPURender", m_FrameProfiler.GetGPUHistory(), static_cast<int>(m_FrameProfiler.GetHistoryCount()),
+            static_cast<int>(m_FrameProfiler.GetHistoryOffset()), nullptr, 0.0f, std::max(GPUStatistics.MaxMs, 0.001f), ImVec2(PlotSize.x * 2.0f, PlotHeight));
+    }
+
+    DrawBackendTelemetry();
+}
+
+void IERenderer::SetDamageTrackingEnabled(bool bEnabled)
+{
+    m_bDamageTrackingEnabled = bEnabled;
+    InvalidatePresentedDrawData();
+}
+
+bool IERenderer::HasDrawDataChanged(const ImDrawData& DrawData)
+{
+    bool bHasDrawDataChanged = true;
+    if (m_bDamageTrackingEnabled)
+    {
+        m_PendingDrawDataHash = ComputeDrawDataHash(DrawData);
+        if (m_PresentedDrawDataHash.has_value() && m_PresentedDrawDataHash.value() == m_PendingDrawDataHash)
+        {
+            m_SkippedFrameCount++;
+            bHasDrawDataChanged = false;
+        }
+    }
+    return bHasDrawDataChanged;
+}
+
+void IERenderer::OnDrawDataPresented()
+{
+    m_RenderedFrameCount++;
+    if (m_bDamageTrackingEnabled)
+    {
+        m_PresentedDrawDataHash = m_PendingDrawDataHash;
+    }
+}
+
+uint64_t IERenderer::ComputeDrawDataHash(const ImDrawData& DrawData)
+{
+    // Word at a time multiply-xorshift mixing, hashing the vertex and index buffers dominates and runs at several GB/s
+    static constexpr uint64_t HashMultiplier = 0x9E3779B97F4A7C15ull;
+    uint64_t Hash = 0xCBF29CE484222325ull;
+    auto HashBytes = [&Hash](const void* Data, size_t Size)
+    {
+        const uint8_t* Bytes = static_cast<const uint8_t*>(Data);
+        for (; Size >= sizeof(uint64_t); Bytes += sizeof(uint64_t), Size -= sizeof(uint64_t))
+        {
+            uint64_t Word;
+            std::memcpy(&Word, Bytes, sizeof(uint64_t));
+            Hash = (Hash ^ Word) * HashMultiplier;
+            Hash ^= Hash >> 29;
+        }
+        if (Size > 0)
+        {
+            uint64_t Tail = 0;
+            std::memcpy(&Tail, Bytes, Size);
+            Hash = (Hash ^ Tail ^ (static_cast<uint64_t>(Size) << 56)) * HashMultiplier;
+            Hash ^= Hash >> 29;
+        }
+    };
+
+    HashBytes(&DrawData.DisplayPos, sizeof(DrawData.DisplayPos));
+    HashBytes(&DrawData.DisplaySize, sizeof(DrawData.DisplaySize));
+    HashBytes(&DrawData.FramebufferScale, sizeof(DrawData.FramebufferScale));
+    HashBytes(&DrawData.CmdListsCount, sizeof(DrawData.CmdListsCount));
+    for (int CmdListIndex = 0; CmdListIndex < DrawData.CmdListsCount; CmdListIndex++)
+    {
+        const ImDrawList& CmdList = *DrawData.CmdLists[CmdListIndex];
+        HashBytes(CmdList.VtxBuffer.Data, static_cast<size_t>(CmdList.VtxBuffer.Size) * sizeof(ImDrawVert));
+        HashBytes(CmdList.IdxBuffer.Data, static_cast<size_t>(CmdList.IdxBuffer.Size) * sizeof(ImDrawIdx));
+        for (const ImDrawCmd& Cmd : CmdList.CmdBuffer)
+        {
+            if (Cmd.UserCallback)
+            {
+                // Callbacks may draw anything, never treat such a frame as unchanged
+                const int64_t CurrentTicks = IEClock::now().time_since_epoch().count();
+                HashBytes(&CurrentTicks, sizeof(CurrentTicks));
+            }
+            HashBytes(&Cmd.ClipRect, sizeof(Cmd.ClipRect));
+            HashBytes(&Cmd.TextureId, sizeof(Cmd.TextureId));
+            HashBytes(&Cmd.VtxOffset, sizeof(Cmd.VtxOffset));
+            HashBytes(&Cmd.IdxOffset, sizeof(Cmd.IdxOffset));
+            HashBytes(&Cmd.ElemCount, sizeof(Cmd.ElemCount));
+        }
+    }
+    return Hash;
+}
+
 void IERenderer::InitializeOSApp()
 {
 #if defined (_WIN32)
@@ -288,26 +836,31 @@ IEResult IERenderer_Vulkan::Initialize(const std::string& AppName, bool bAllowRu
         if (m_AppWindow)
         {
             m_bAllowRunInBackground = bAllowRunInBackground && OS_SUPPORT_RUN_IN_BACKGROUND;
+            if (m_bAllowRunInBackground && !IELogger::IsFileSinkOpen())
+            {
+                // Background instances have no terminal to look at, keep their history on disk instead
+                IELogger::FileSinkConfig FileSinkConfig;
+                FileSinkConfig.BaseName = m_AppName;
+                FileSinkConfig.bMirrorToConsole = false;
+                IELogger::StartFileSink(FileSinkConfig);
+            }
             PostWindowCreated();
-            if (InitializeVulkan())
+            m_VkAllocationCallback = m_bHostAllocatorEnabled ? m_HostAllocator.GetAllocationCallbacks() : nullptr;
+            const IEResult VulkanResult = InitializeVulkan();
+            if (VulkanResult.Type == IEResult::Type::Success)
             {
-                if (glfwCreateWindowSurface(m_VkInstance, m_AppWindow, m_VkAllocationCallback, &m_AppWindowVulkanData.Surface) == VkResult::VK_SUCCESS)
-                {
-                    glfwGetFramebufferSize(m_AppWindow, &m_DefaultAppWindowWidth, &m_DefaultAppWindowHeight);
-
-                    VkBool32 PhysicalDeviceSurfaceSupport = false;
-                    vkGetPhysicalDeviceSurfaceSupportKHR(m_VkPhysicalDevice, m_QueueFamilyIndex, m_AppWindowVulkanData.Surface, &PhysicalDeviceSurfaceSupport);
-                    if (PhysicalDeviceSurfaceSupport == VK_TRUE)
-                    {
-                        Result.Type = IEResult::Type::Success;
-                        Result.Message = "Successfully initialized IERenderer";
-                    }
-                    else
-                    {
-                        Result.Type = IEResult::Type::NotSupported;
-                        Result.Message = "Physical device is not supported";
-                    }
-                }
+                Result = CreateWindowSurface()
+                    .transform([this](VkSurfaceKHR Surface)
+                        {
+                            m_AppWindowVulkanData.Surface = Surface;
+                            glfwGetFramebufferSize(m_AppWindow, &m_DefaultAppWindowWidth, &m_DefaultAppWindowHeight);
+                            return Surface;
+                        })
+                    .ToResult("Successfully initialized IERenderer");
+            }
+            else
+            {
+                Result = VulkanResult;
             }
         }
     }
@@ -318,24 +871,15 @@ IEResult IERenderer_Vulkan::PostImGuiContextCreated()
 {
     IEResult Result(IEResult::Type::Fail, "Failed to initialize ImGuiContext with Vulkan");
 
-    const int VkFormatNum = 4;
-    const VkFormat RequestSurfaceImageFormats[VkFormatNum] = {  VK_FORMAT_B8G8R8A8_UNORM,
-                                                                VK_FORMAT_R8G8B8A8_UNORM,
-                                                                VK_FORMAT_B8G8R8_UNORM,
-                                                                VK_FORMAT_R8G8B8_UNORM };
-
-    const VkColorSpaceKHR RequestSurfaceColorSpace = VK_COLORSPACE_SRGB_NONLINEAR_KHR;
-    m_AppWindowVulkanData.SurfaceFormat = ImGui_ImplVulkanH_SelectSurfaceFormat(m_VkPhysicalDevice, m_AppWindowVulkanData.Surface,
-        RequestSurfaceImageFormats, VkFormatNum, RequestSurfaceColorSpace);
-
-    const int PresentModeKHRNum = 1;
-    VkPresentModeKHR PresentModeKHR[PresentModeKHRNum] = { VK_PRESENT_MODE_FIFO_KHR };
-    m_AppWindowVulkanData.PresentMode = ImGui_ImplVulkanH_SelectPresentMode(m_VkPhysicalDevice, m_AppWindowVulkanData.Surface, PresentModeKHR, PresentModeKHRNum);
-
+    const IEClock::time_point StartTime = IEClock::now();
+    const bool bWarmPipelineCache = CreatePipelineCache();
+    SelectSurfaceFormatAndPresentMode();
     ImGui_ImplVulkanH_CreateOrResizeWindow(m_VkInstance, m_VkPhysicalDevice, m_VkDevice, &m_AppWindowVulkanData, m_QueueFamilyIndex, m_VkAllocationCallback,
         m_DefaultAppWindowWidth, m_DefaultAppWindowHeight, m_MinImageCount);
+    ReleaseUnusedImGuiFrameResources();
+    CreateTimestampQueryPool();
 
-    if (ImGui_ImplGlfw_InitForVulkan(m_AppWindow, true))
+    if (CreateFramesInFlight() && ImGui_ImplGlfw_InitForVulkan(m_AppWindow, false))
     {
         ImGui_ImplVulkan_InitInfo VulkanInitInfo = {};
         VulkanInitInfo.Instance = m_VkInstance;
@@ -348,7 +892,8 @@ IEResult IERenderer_Vulkan::PostImGuiContextCreated()
         VulkanInitInfo.RenderPass = m_AppWindowVulkanData.RenderPass;
         VulkanInitInfo.Subpass = 0;
         VulkanInitInfo.MinImageCount = m_MinImageCount;
-        VulkanInitInfo.ImageCount = m_AppWindowVulkanData.ImageCount;
+        // ImGui rotates its vertex and index buffers over ImageCount, it must cover every frame that can be in flight
+        VulkanInitInfo.ImageCount = std::max(m_AppWindowVulkanData.ImageCount, MaxFramesInFlight);
         VulkanInitInfo.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
         VulkanInitInfo.Allocator = m_VkAllocationCallback;
         VulkanInitInfo.MinAllocationSize = 1024 * 1024; // TODO Magic Number
@@ -356,46 +901,288 @@ IEResult IERenderer_Vulkan::PostImGuiContextCreated()
         VulkanInitInfo.CheckVkResultFn = &IERenderer_Vulkan::CheckVkResultFunc;
         if (ImGui_ImplVulkan_Init(&VulkanInitInfo))
         {
+            m_bImGuiBackendsInitialized = true;
+            if (m_bRenderThreadEnabled)
+            {
+                StartRenderThread();
+            }
+            IELOG_CATEGORY_INFO(Renderer, "PostImGuiContextCreated took %.2f ms with a %s pipeline cache",
+                std::chrono::duration<double, std::milli>(IEClock::now() - StartTime).count(), bWarmPipelineCache ? "warm" : "cold");
+            // Persists the ImGui pipeline right away, later saves only happen when the cache grew
+            SavePipelineCache();
             Result.Type = IEResult::Type::Success;
             Result.Message = "Successfully initialized ImGuiContext with Vulkan";
         }
+        else
+        {
+            ImGui_ImplGlfw_Shutdown();
+        }
     }
     return Result;
 }
 
 void IERenderer_Vulkan::Deinitialize()
 {
-    ImGui_ImplVulkan_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+    StopRenderThread();
+    StopInputRecording();
+    DestroyTimestampQueryPool();
+    // Deinitialize also runs after a failed PostImGuiContextCreated or ImGui::CreateContext
+    if (m_bImGuiBackendsInitialized)
+    {
+        ImGui_ImplVulkan_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+        m_bImGuiBackendsInitialized = false;
+    }
 
-    ImGui::DestroyContext();
+    if (ImGui::GetCurrentContext())
+    {
+        ImGui::DestroyContext();
+    }
     ImGui_ImplVulkanH_DestroyWindow(m_VkInstance, m_VkDevice, &m_AppWindowVulkanData, m_VkAllocationCallback);
+    DestroyFramesInFlight();
 
     DinitializeVulkan();
 
     glfwDestroyWindow(m_AppWindow);
     glfwTerminate();
+    WaitForPipelineCacheSave();
+
+    if (m_bAllowRunInBackground)
+    {
+        IELogger::StopFileSink();
+    }
+}
+
+void IERenderer_Vulkan::ReleaseWindowResources()
+{
+    if (!m_bWindowResourcesReleased && m_VkDevice && m_AppWindowVulkanData.Swapchain)
+    {
+        const uint64_t ResidentBytesBefore = IEUtils::GetResidentMemoryBytes();
+        const uint64_t DeviceBytesBefore = GetDeviceMemoryUsageBytes();
+
+        WaitForRenderThreadIdle();
+        vkDeviceWaitIdle(m_VkDevice);
+        DestroyTimestampQueryPool();
+        // Per frame command pools, fences and semaphores are recreated on restore with the current frames in flight count
+        DestroyFramesInFlight();
+        ImGui_ImplVulkan_DestroyFontsTexture();
+        // The atlas is rebuilt from the retained font data on restore
+        ImGui::GetIO().Fonts->ClearTexData();
+        // Also destroys the surface, the device, descriptor pool and ImGui pipeline are kept for a fast restore
+        ImGui_ImplVulkanH_DestroyWindow(m_VkInstance, m_VkDevice, &m_AppWindowVulkanData, m_VkAllocationCallback);
+        if (m_VkAllocationCallback)
+        {
+            // Blocks freed by the driver above would otherwise stay cached in the host allocator pools
+            IELOG_CATEGORY_INFO(Renderer, "Trimmed %.1f KiB of pooled host allocations", m_HostAllocator.Trim() / 1024.0);
+        }
+        m_bWindowResourcesReleased = true;
+
+        IELOG_CATEGORY_INFO(Renderer, "Released window resources, resident %.1f -> %.1f MiB, device %.1f -> %.1f MiB",
+            ResidentBytesBefore / 1048576.0, IEUtils::GetResidentMemoryBytes() / 1048576.0, DeviceBytesBefore / 1048576.0, GetDeviceMemoryUsageBytes() / 1048576.0);
+    }
+}
+
+bool IERenderer_Vulkan::RestoreWindowResources()
+{
+    if (m_bWindowResourcesReleased)
+    {
+        const IEClock::time_point StartTime = IEClock::now();
+        const uint64_t ResidentBytesBefore = IEUtils::GetResidentMemoryBytes();
+        const uint64_t DeviceBytesBefore = GetDeviceMemoryUsageBytes();
+
+        IEResult Result(IEResult::Type::Fail, "Failed to recreate frames in flight");
+        if (CreateFramesInFlight())
+        {
+            Result = CreateWindowSurface()
+                .transform([this](VkSurfaceKHR Surface)
+                    {
+                        m_AppWindowVulkanData.Surface = Surface;
+                        SelectSurfaceFormatAndPresentMode();
+
+                        int FrameBufferWidth = 0, FrameBufferHeight = 0;
+                        glfwGetFramebufferSize(m_AppWindow, &FrameBufferWidth, &FrameBufferHeight);
+                        ImGui_ImplVulkanH_CreateOrResizeWindow(m_VkInstance, m_VkPhysicalDevice, m_VkDevice, &m_AppWindowVulkanData, m_QueueFamilyIndex, m_VkAllocationCallback,
+                            FrameBufferWidth > 0 ? FrameBufferWidth : m_DefaultAppWindowWidth, FrameBufferHeight > 0 ? FrameBufferHeight : m_DefaultAppWindowHeight, m_MinImageCount);
+                        ReleaseUnusedImGuiFrameResources();
+                        CreateTimestampQueryPool();
+                        ImGui_ImplVulkan_CreateFontsTexture();
+                        return Surface;
+                    })
+                .ToResult("Restored window resources");
+            if (Result.Type != IEResult::Type::Success)
+            {
+                DestroyFramesInFlight();
+            }
+        }
+
+        if (Result.Type == IEResult::Type::Success)
+        {
+            m_bWindowResourcesReleased = false;
+            m_AppWindowVulkanData.FrameIndex = 0;
+            InvalidatePresentedDrawData();
+            IELOG_CATEGORY_INFO(Renderer, "Restored window resources in %.2f ms, resident %.1f -> %.1f MiB, device %.1f -> %.1f MiB",
+                std::chrono::duration<double, std::milli>(IEClock::now() - StartTime).count(),
+                ResidentBytesBefore / 1048576.0, IEUtils::GetResidentMemoryBytes() / 1048576.0, DeviceBytesBefore / 1048576.0, GetDeviceMemoryUsageBytes() / 1048576.0);
+        }
+        else
+        {
+            IELOG_CATEGORY_ERROR(Renderer, "Failed to restore window resources: %s", Result.Message.ToString().c_str());
+        }
+    }
+    return !m_bWindowResourcesReleased;
+}
+
+void IERenderer_Vulkan::SelectSurfaceFormatAndPresentMode()
+{
+    const int VkFormatNum = 4;
+    const VkFormat RequestSurfaceImageFormats[VkFormatNum] = {  VK_FORMAT_B8G8R8A8_UNORM,
+                                                                VK_FORMAT_R8G8B8A8_UNORM,
+                                                                VK_FORMAT_B8G8R8_UNORM,
+                                                                VK_FORMAT_R8G8B8_UNORM };
+
+    const VkColorSpaceKHR RequestSurfaceColorSpace = VK_COLORSPACE_SRGB_NONLINEAR_KHR;
+    m_AppWindowVulkanData.SurfaceFormat = ImGui_ImplVulkanH_SelectSurfaceFormat(m_VkPhysicalDevice, m_AppWindowVulkanData.Surface,
+        RequestSurfaceImageFormats, VkFormatNum, RequestSurfaceColorSpace);
+
+    SelectPresentMode();
+}
+
+void IERenderer_Vulkan::SelectPresentMode()
+{
+    // Ordered by preference, ImGui_ImplVulkanH_SelectPresentMode takes the first supported one and falls back to FIFO
+    std::array<VkPresentModeKHR, 3> PresentModeKHR = { VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_KHR };
+    switch (m_LatencyMode)
+    {
+    case IELatencyMode::Balanced:
+        PresentModeKHR = { VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_FIFO_KHR };
+        m_MinImageCount = 3;
+        break;
+    case IELatencyMode::LowLatency:
+        PresentModeKHR = { VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_RELAXED_KHR, VK_PRESENT_MODE_FIFO_KHR };
+        m_MinImageCount = 3;
+        break;
+    case IELatencyMode::Uncapped:
+        PresentModeKHR = { VK_PRESENT_MODE_IMMEDIATE_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_FIFO_KHR };
+        m_MinImageCount = 2;
+        break;
+    case IELatencyMode::PowerSaving:
+    default:
+        m_MinImageCount = 2;
+        break;
+    }
+    m_AppWindowVulkanData.PresentMode = ImGui_ImplVulkanH_SelectPresentMode(m_VkPhysicalDevice, m_AppWindowVulkanData.Surface,
+        PresentModeKHR.data(), static_cast<int>(PresentModeKHR.size()));
+    // Mailbox keeps one image queued on top of the displayed one and the one being rendered
+    if (m_AppWindowVulkanData.PresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+    {
+        m_MinImageCount = std::max(m_MinImageCount, 3);
+    }
+
+    IELOG_CATEGORY_INFO(Renderer, "Latency mode %s, present mode %d, %d swapchain images", GetIELatencyModeName(m_LatencyMode),
+        static_cast<int>(m_AppWindowVulkanData.PresentMode), m_MinImageCount);
+}
+
+void IERenderer_Vulkan::SetHostAllocatorEnabled(bool bEnabled)
+{
+    if (m_VkInstance)
+    {
+        IELOG_CATEGORY_WARNING(Renderer, "The host allocator can only be changed before Initialize");
+    }
+    else
+    {
+        m_bHostAllocatorEnabled = bEnabled;
+    }
+}
+
+void IERenderer_Vulkan::DrawBackendTelemetry() const
+{
+    if (m_VkAllocationCallback)
+    {
+        ImGui::Text("%-14s %9s %9s %11s %7s %8s %7s", "Host Scope", "Live KiB", "Peak KiB", "Cached KiB", "Allocs", "Pooled", "System");
+        for (uint32_t ScopeIndex = 0; ScopeIndex < IEVulkanHostAllocator::ScopeCount; ScopeIndex++)
+        {
+            const VkSystemAllocationScope Scope = static_cast<VkSystemAllocationScope>(ScopeIndex);
+            const IEVulkanHostAllocator::ScopeStatistics Statistics = m_HostAllocator.GetScopeStatistics(Scope);
+            ImGui::Text("%-14s %9.1f %9.1f %11.1f %7llu %8llu %7llu", IEVulkanHostAllocator::GetScopeName(Scope), Statistics.LiveBytes / 1024.0, Statistics.PeakBytes / 1024.0,
+                Statistics.CachedBytes / 1024.0, static_cast<unsigned long long>(Statistics.LiveAllocationCount), static_cast<unsigned long long>(Statistics.PooledAllocationCount),
+                static_cast<unsigned long long>(Statistics.SystemAllocationCount));
+        }
+    }
+}
+
+void IERenderer_Vulkan::SetLatencyMode(IELatencyMode LatencyMode)
+{
+    if (LatencyMode != m_LatencyMode)
+    {
+        m_LatencyMode = LatencyMode;
+        // Before initialization the mode is picked up by PostImGuiContextCreated
+        if (m_AppWindowVulkanData.Swapchain && !m_bWindowResourcesReleased)
+        {
+            m_bPresentModeChanged = true;
+            m_SwapChainRebuild = true;
+        }
+    }
+}
+
+uint64_t IERenderer_Vulkan::GetDeviceMemoryUsageBytes() const
+{
+    uint64_t DeviceMemoryUsageBytes = 0;
+
+    // Only valid to query when negotiated, see NegotiateDeviceExtensions
+    const bool bMemoryBudgetSupported = IsDeviceExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    const PFN_vkGetPhysicalDeviceMemoryProperties2KHR GetPhysicalDeviceMemoryProperties2 =
+        reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(vkGetInstanceProcAddr(m_VkInstance, "vkGetPhysicalDeviceMemoryProperties2KHR"));
+    if (bMemoryBudgetSupported && GetPhysicalDeviceMemoryProperties2)
+    {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT MemoryBudgetProperties = {};
+        MemoryBudgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 MemoryProperties = {};
+        MemoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        MemoryProperties.pNext = &MemoryBudgetProperties;
+        GetPhysicalDeviceMemoryProperties2(m_VkPhysicalDevice, &MemoryProperties);
+
+        for (uint32_t HeapIndex = 0; HeapIndex < MemoryProperties.memoryProperties.memoryHeapCount; HeapIndex++)
+        {
+            if (MemoryProperties.memoryProperties.memoryHeaps[HeapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            {
+                DeviceMemoryUsageBytes += MemoryBudgetProperties.heapUsage[HeapIndex];
+            }
+        }
+    }
+    return DeviceMemoryUsageBytes;
 }
 
 int32_t IERenderer_Vulkan::FlushGPUCommandsAndWait()
 {
+    WaitForRenderThreadIdle();
     return vkDeviceWaitIdle(m_VkDevice);
 }
 
 void IERenderer_Vulkan::CheckAndResizeSwapChain()
 {
+    IEFrameStageTimer StageTimer(m_FrameProfiler, IEFrameStage::CheckAndResizeSwapChain);
+
     int FrameBufferWidth = 0, FrameBufferHeight = 0;
     glfwGetFramebufferSize(m_AppWindow, &FrameBufferWidth, &FrameBufferHeight);
 
-    if (FrameBufferWidth > 0 && FrameBufferHeight > 0 &&
+    if (!m_bWindowResourcesReleased && FrameBufferWidth > 0 && FrameBufferHeight > 0 &&
         (m_SwapChainRebuild ||
             m_AppWindowVulkanData.Width != FrameBufferWidth ||
             m_AppWindowVulkanData.Height != FrameBufferHeight))
     {
+        IELOG_CATEGORY_INFO_EVERY_MS(Frame, 1000, "Rebuilding swapchain (%dx%d)", FrameBufferWidth, FrameBufferHeight);
+        WaitForRenderThreadIdle();
+        if (m_bPresentModeChanged)
+        {
+            SelectPresentMode();
+            m_bPresentModeChanged = false;
+        }
         ImGui_ImplVulkan_SetMinImageCount(m_MinImageCount);
         ImGui_ImplVulkanH_CreateOrResizeWindow(m_VkInstance, m_VkPhysicalDevice,
             m_VkDevice, &m_AppWindowVulkanData, m_QueueFamilyIndex, m_VkAllocationCallback,
             FrameBufferWidth, FrameBufferHeight, m_MinImageCount);
+        ReleaseUnusedImGuiFrameResources();
+        InvalidatePresentedDrawData();
 
         m_AppWindowVulkanData.FrameIndex = 0;
         m_SwapChainRebuild = false;
@@ -404,100 +1191,538 @@ void IERenderer_Vulkan::CheckAndResizeSwapChain()
 
 void IERenderer_Vulkan::NewFrame()
 {
+    IEFrameStageTimer StageTimer(m_FrameProfiler, IEFrameStage::NewFrame);
+
+    const bool bReplayingInput = m_InputLayer.IsReplaying();
+    m_InputLayer.DispatchEvents(m_AppWindow);
     ImGui_ImplVulkan_NewFrame();
     ImGui_ImplGlfw_NewFrame();
+    if (bReplayingInput)
+    {
+        ImGui::GetIO().DeltaTime = std::chrono::duration<float>(m_ReplayDeltaTime).count();
+    }
 }
 
 void IERenderer_Vulkan::RenderFrame(ImDrawData& DrawData)
 {
+    IE_PROFILE_SCOPE("IERenderer_Vulkan::RenderFrame");
     const bool bIsMinimized = (DrawData.DisplaySize.x <= 0.0f || DrawData.DisplaySize.y <= 0.0f);
-    if (!bIsMinimized)
+    if (m_bSnapshotDropped.exchange(false, std::memory_order_acquire))
+    {
+        InvalidatePresentedDrawData();
+    }
+    const bool bFrameSkipped = m_bWindowResourcesReleased || (!bIsMinimized && !HasDrawDataChanged(DrawData));
+    m_bFrameSubmitted = false;
+    if (!bIsMinimized && !bFrameSkipped)
     {
-        m_AppWindowVulkanData.ClearValue.color.float32[0] = 0.0f;
-        m_AppWindowVulkanData.ClearValue.color.float32[1] = 0.0f;
-        m_AppWindowVulkanData.ClearValue.color.float32[2] = 0.0f;
-        m_AppWindowVulkanData.ClearValue.color.float32[3] = 1.0f;
+        if (m_RenderThread.joinable())
+        {
+            QueueDrawDataSnapshot(DrawData);
+        }
+        else
+        {
+            m_bFrameSubmitted = RecordAndSubmitFrame(DrawData);
+        }
+    }
+}
 
-        VkSemaphore ImageAcquiredSemaphore = m_AppWindowVulkanData.FrameSemaphores[m_AppWindowVulkanData.SemaphoreIndex].ImageAcquiredSemaphore;
-        VkSemaphore RenderCompleteSemaphore = m_AppWindowVulkanData.FrameSemaphores[m_AppWindowVulkanData.SemaphoreIndex].RenderCompleteSemaphore;
+void IERenderer_Vulkan::PresentFrame()
+{
+    if (m_bFrameSubmitted)
+    {
+        if (PresentSubmittedFrame())
+        {
+            OnDrawDataPresented();
+        }
+    }
+    m_FrameProfiler.EndFrame();
+    OnFrameEnded();
+}
+
+bool IERenderer_Vulkan::RecordAndSubmitFrame(ImDrawData& DrawData)
+{
+    bool bSubmitted = false;
+    m_AppWindowVulkanData.ClearValue.color.float32[0] = 0.0f;
+    m_AppWindowVulkanData.ClearValue.color.float32[1] = 0.0f;
+    m_AppWindowVulkanData.ClearValue.color.float32[2] = 0.0f;
+    m_AppWindowVulkanData.ClearValue.color.float32[3] = 1.0f;
+
+    // The slot fence is waited on before acquiring, it bounds how far the CPU runs ahead of the GPU
+    // and guarantees the slot's command buffer and image acquired semaphore are no longer in use
+    FrameInFlight& InFlightFrame = m_FramesInFlight[m_FrameInFlightIndex];
+    IEFrameStageTimer FenceWaitTimer(m_FrameProfiler, IEFrameStage::FenceWait);
+    const VkResult FenceResult = vkWaitForFences(m_VkDevice, 1, &InFlightFrame.Fence, VK_TRUE, UINT64_MAX);
+    FenceWaitTimer.Stop();
+    if (FenceResult != VkResult::VK_SUCCESS)
+    {
+        IELOG_CATEGORY_ERROR_EVERY_MS(Frame, 1000, "Failed to wait for frame fence (VkResult %d)", FenceResult);
+        return false;
+    }
+    CollectTimestampQueries(m_FrameInFlightIndex);
+
+    IEFrameStageTimer AcquireTimer(m_FrameProfiler, IEFrameStage::AcquireImage);
+    uint32_t ImageIndex = 0;
+    const VkResult Result = vkAcquireNextImageKHR(m_VkDevice, m_AppWindowVulkanData.Swapchain, UINT64_MAX, InFlightFrame.ImageAcquiredSemaphore, VK_NULL_HANDLE, &ImageIndex);
+    AcquireTimer.Stop();
+    if (Result == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        m_SwapChainRebuild = true;
+        return false;
+    }
+    else if (Result == VK_SUBOPTIMAL_KHR)
+    {
+        // The image is acquired and the semaphore will signal, the frame still has to be submitted and presented
+        m_SwapChainRebuild = true;
+    }
+    else if (Result != VkResult::VK_SUCCESS)
+    {
+        IELOG_CATEGORY_ERROR_EVERY_MS(Frame, 1000, "Failed to acquire swapchain image (VkResult %d)", Result);
+        return false;
+    }
+    m_AppWindowVulkanData.FrameIndex = ImageIndex;
+
+    // Render complete semaphores are per swapchain image, the presentation engine holds them until the image is reacquired
+    const VkFramebuffer Framebuffer = m_AppWindowVulkanData.Frames[ImageIndex].Framebuffer;
+    VkSemaphore RenderCompleteSemaphore = m_AppWindowVulkanData.FrameSemaphores[ImageIndex].RenderCompleteSemaphore;
+
+    IEFrameStageTimer RecordTimer(m_FrameProfiler, IEFrameStage::RecordCommands);
+    VkResult RecordResult = vkResetCommandPool(m_VkDevice, InFlightFrame.CommandPool, 0); // TODO Magic Number
+    if (RecordResult == VkResult::VK_SUCCESS)
+    {
+        VkCommandBufferBeginInfo CommandBufferBeginInfo = {};
+        CommandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        CommandBufferBeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        RecordResult = vkBeginCommandBuffer(InFlightFrame.CommandBuffer, &CommandBufferBeginInfo);
+    }
+    if (RecordResult == VkResult::VK_SUCCESS)
+    {
+        VkRenderPassBeginInfo RenderPassBeginInfo = {};
+        RenderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        RenderPassBeginInfo.renderPass = m_AppWindowVulkanData.RenderPass;
+        RenderPassBeginInfo.framebuffer = Framebuffer;
+        RenderPassBeginInfo.renderArea.extent.width = m_AppWindowVulkanData.Width;
+        RenderPassBeginInfo.renderArea.extent.height = m_AppWindowVulkanData.Height;
+        RenderPassBeginInfo.pClearValues = &m_AppWindowVulkanData.ClearValue;
+        RenderPassBeginInfo.clearValueCount = 1; // TODO Magic Number
+
+        WriteTimestampQuery(InFlightFrame.CommandBuffer, m_FrameInFlightIndex, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+        vkCmdBeginRenderPass(InFlightFrame.CommandBuffer, &RenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        ImGui_ImplVulkan_RenderDrawData(&DrawData, InFlightFrame.CommandBuffer);
+        vkCmdEndRenderPass(InFlightFrame.CommandBuffer);
+        WriteTimestampQuery(InFlightFrame.CommandBuffer, m_FrameInFlightIndex, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+        RecordResult = vkEndCommandBuffer(InFlightFrame.CommandBuffer);
+    }
+    RecordTimer.Stop();
 
-        const VkResult Result = vkAcquireNextImageKHR(m_VkDevice, m_AppWindowVulkanData.Swapchain, UINT64_MAX, ImageAcquiredSemaphore, VK_NULL_HANDLE, &m_AppWindowVulkanData.FrameIndex);
-        if (Result == VK_ERROR_OUT_OF_DATE_KHR || Result == VK_SUBOPTIMAL_KHR)
+    bool bFenceReset = false;
+    if (RecordResult == VkResult::VK_SUCCESS)
+    {
+        IEFrameStageTimer SubmitTimer(m_FrameProfiler, IEFrameStage::Submit);
+        VkPipelineStageFlags PipelineStageFlags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        VkSubmitInfo SubmitInfo = {};
+        SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        SubmitInfo.waitSemaphoreCount = 1;
+        SubmitInfo.pWaitSemaphores = &InFlightFrame.ImageAcquiredSemaphore;
+        SubmitInfo.pWaitDstStageMask = &PipelineStageFlags;
+        SubmitInfo.commandBufferCount = 1; // TODO Magic Number
+        SubmitInfo.pCommandBuffers = &InFlightFrame.CommandBuffer;
+        SubmitInfo.signalSemaphoreCount = 1; // TODO Magic Number
+        SubmitInfo.pSignalSemaphores = &RenderCompleteSemaphore;
+
+        // Reset right before the submit that signals it again, a failure in between would leave the next wait on this slot hanging
+        VkResult SubmitResult = vkResetFences(m_VkDevice, 1, &InFlightFrame.Fence);
+        bFenceReset = SubmitResult == VkResult::VK_SUCCESS;
+        if (bFenceReset)
         {
-            m_SwapChainRebuild = true;
-            return;
+            SubmitResult = vkQueueSubmit(m_VkQueue, 1, &SubmitInfo, InFlightFrame.Fence);
+        }
+        if (SubmitResult != VkResult::VK_SUCCESS)
+        {
+            IELOG_CATEGORY_ERROR_EVERY_MS(Frame, 1000, "Failed to submit frame (VkResult %d)", SubmitResult);
         }
+        bSubmitted = SubmitResult == VkResult::VK_SUCCESS;
+    }
+    else
+    {
+        IELOG_CATEGORY_ERROR_EVERY_MS(Frame, 1000, "Failed to record frame (VkResult %d)", RecordResult);
+    }
+
+    if (bSubmitted)
+    {
+        m_FrameInFlightIndex = (m_FrameInFlightIndex + 1) % m_FramesInFlightCount;
+    }
+    else
+    {
+        RecoverFrameInFlight(m_FrameInFlightIndex, bFenceReset);
+    }
+    return bSubmitted;
+}
 
-        ImGui_ImplVulkanH_Frame& VulkanFrame = m_AppWindowVulkanData.Frames[m_AppWindowVulkanData.FrameIndex];
-        if (vkWaitForFences(m_VkDevice, 1, &VulkanFrame.Fence, VK_TRUE, UINT64_MAX) == VkResult::VK_SUCCESS) // TODO Magic Number
+void IERenderer_Vulkan::RecoverFrameInFlight(uint32_t FrameInFlightIndex, bool bFenceReset)
+{
+    FrameInFlight& InFlightFrame = m_FramesInFlight[FrameInFlightIndex];
+
+    // The image was acquired, so its semaphore will signal and the next acquire on this slot reuses it.
+    // An empty batch consumes that signal and signals the fence again if it was already reset.
+    VkPipelineStageFlags PipelineStageFlags = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    VkSubmitInfo SubmitInfo = {};
+    SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    SubmitInfo.waitSemaphoreCount = 1;
+    SubmitInfo.pWaitSemaphores = &InFlightFrame.ImageAcquiredSemaphore;
+    SubmitInfo.pWaitDstStageMask = &PipelineStageFlags;
+    if (vkQueueSubmit(m_VkQueue, 1, &SubmitInfo, bFenceReset ? InFlightFrame.Fence : VK_NULL_HANDLE) != VkResult::VK_SUCCESS)
+    {
+        // Last resort, replaces the slot's sync objects once the queue is idle
+        vkDeviceWaitIdle(m_VkDevice);
+        vkDestroySemaphore(m_VkDevice, InFlightFrame.ImageAcquiredSemaphore, m_VkAllocationCallback);
+        InFlightFrame.ImageAcquiredSemaphore = VK_NULL_HANDLE;
+        VkSemaphoreCreateInfo SemaphoreCreateInfo = {};
+        SemaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        vkCreateSemaphore(m_VkDevice, &SemaphoreCreateInfo, m_VkAllocationCallback, &InFlightFrame.ImageAcquiredSemaphore);
+        if (bFenceReset)
         {
-            if (vkResetFences(m_VkDevice, 1, &VulkanFrame.Fence) == VkResult::VK_SUCCESS)
+            vkDestroyFence(m_VkDevice, InFlightFrame.Fence, m_VkAllocationCallback);
+            InFlightFrame.Fence = VK_NULL_HANDLE;
+            VkFenceCreateInfo FenceCreateInfo = {};
+            FenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            FenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+            vkCreateFence(m_VkDevice, &FenceCreateInfo, m_VkAllocationCallback, &InFlightFrame.Fence);
+        }
+    }
+
+    // The acquired image is never presented, the rebuild hands it back to the presentation engine
+    m_SwapChainRebuild = true;
+}
+
+bool IERenderer_Vulkan::PresentSubmittedFrame()
+{
+    bool bPresented = false;
+    IEFrameStageTimer StageTimer(m_FrameProfiler, IEFrameStage::PresentFrame);
+    const VkSemaphore RenderCompleteSemaphore = m_AppWindowVulkanData.FrameSemaphores[m_AppWindowVulkanData.FrameIndex].RenderCompleteSemaphore;
+
+    VkPresentInfoKHR PresentInfoKHR = {};
+    PresentInfoKHR.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    PresentInfoKHR.waitSemaphoreCount = 1; // TODO Magic Number
+    PresentInfoKHR.pWaitSemaphores = &RenderCompleteSemaphore;
+    PresentInfoKHR.swapchainCount = 1; // TODO Magic Number
+    PresentInfoKHR.pSwapchains = &m_AppWindowVulkanData.Swapchain;
+    PresentInfoKHR.pImageIndices = &m_AppWindowVulkanData.FrameIndex;
+
+    const VkResult Result = vkQueuePresentKHR(m_VkQueue, &PresentInfoKHR);
+    if (Result == VK_ERROR_OUT_OF_DATE_KHR || Result == VK_SUBOPTIMAL_KHR)
+    {
+        m_SwapChainRebuild = true;
+    }
+    else if (Result != VkResult::VK_SUCCESS)
+    {
+        IELOG_CATEGORY_ERROR_EVERY_MS(Frame, 1000, "Failed to present frame (VkResult %d)", Result);
+    }
+    else
+    {
+        bPresented = true;
+    }
+    return bPresented;
+}
+
+void IERenderer_Vulkan::SetRenderThreadEnabled(bool bEnabled)
+{
+    m_bRenderThreadEnabled = bEnabled;
+    if (!bEnabled)
+    {
+        StopRenderThread();
+    }
+    else if (m_VkDevice)
+    {
+        // Otherwise started by PostImGuiContextCreated
+        StartRenderThread();
+    }
+}
+
+void IERenderer_Vulkan::StartRenderThread()
+{
+    if (!m_RenderThread.joinable())
+    {
+        m_bRenderThreadExitRequested = false;
+        m_RenderThread = std::thread(&IERenderer_Vulkan::RenderThreadLoop, this);
+        IELOG_CATEGORY_INFO(Renderer, "Render thread started");
+    }
+}
+
+void IERenderer_Vulkan::StopRenderThread()
+{
+    if (m_RenderThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> Lock(m_RenderThreadMutex);
+            m_bRenderThreadExitRequested = true;
+        }
+        m_RenderThreadCondition.notify_all();
+        // A queued frame is still rendered before the thread exits
+        m_RenderThread.join();
+        IELOG_CATEGORY_INFO(Renderer, "Render thread stopped");
+    }
+}
+
+void IERenderer_Vulkan::WaitForRenderThreadIdle()
+{
+    if (m_RenderThread.joinable())
+    {
+        std::unique_lock<std::mutex> Lock(m_RenderThreadMutex);
+        m_RenderThreadCondition.wait(Lock, [this]() { return m_QueuedSnapshotIndex < 0 && m_RenderingSnapshotIndex < 0; });
+    }
+}
+
+void IERenderer_Vulkan::QueueDrawDataSnapshot(const ImDrawData& DrawData)
+{
+    std::unique_lock<std::mutex> Lock(m_RenderThreadMutex);
+    // At most one frame waits behind the one being rendered, beyond that the UI thread is throttled to the render thread
+    m_RenderThreadCondition.wait(Lock, [this]() { return m_QueuedSnapshotIndex < 0; });
+    const int32_t SnapshotIndex = m_RenderingSnapshotIndex == 0 ? 1 : 0;
+    Lock.unlock();
+
+    {
+        IE_PROFILE_SCOPE("IERenderer_Vulkan::CaptureDrawData");
+        m_DrawDataSnapshots[SnapshotIndex].Capture(DrawData);
+    }
+
+    Lock.lock();
+    m_QueuedSnapshotIndex = SnapshotIndex;
+    Lock.unlock();
+    m_RenderThreadCondition.notify_all();
+
+    // Counted as presented once handed over so the hash stays owned by the UI thread, RenderThreadLoop flags the snapshot if it is dropped
+    OnDrawDataPresented();
+}
+
+void IERenderer_Vulkan::RenderThreadLoop()
+{
+    IEProfiler::SetCurrentThreadName("Render");
+
+    std::unique_lock<std::mutex> Lock(m_RenderThreadMutex);
+    while (true)
+    {
+        m_RenderThreadCondition.wait(Lock, [this]() { return m_QueuedSnapshotIndex >= 0 || m_bRenderThreadExitRequested; });
+        if (m_QueuedSnapshotIndex < 0)
+        {
+            break;
+        }
+
+        const int32_t SnapshotIndex = m_QueuedSnapshotIndex;
+        m_RenderingSnapshotIndex = SnapshotIndex;
+        m_QueuedSnapshotIndex = -1;
+        Lock.unlock();
+        m_RenderThreadCondition.notify_all();
+
+        // Frames queued after an out of date swapchain are dropped until the UI thread rebuilt it
+        bool bPresented = false;
+        if (!m_SwapChainRebuild)
+        {
+            IE_PROFILE_SCOPE("IERenderer_Vulkan::RenderThreadFrame");
+            bPresented = RecordAndSubmitFrame(m_DrawDataSnapshots[SnapshotIndex].GetDrawData()) && PresentSubmittedFrame();
+        }
+        if (!bPresented)
+        {
+            // The UI thread invalidates its hash on the next frame, which is requested right away in case the UI is idle
+            m_bSnapshotDropped.store(true, std::memory_order_release);
+            RequestRedrawAt(IEClock::now());
+        }
+
+        Lock.lock();
+        m_RenderingSnapshotIndex = -1;
+        m_RenderThreadCondition.notify_all();
+    }
+}
+
+void IERenderer_Vulkan::SetFramesInFlight(uint32_t Count)
+{
+    const uint32_t FramesInFlightCount = std::clamp(Count, 1u, MaxFramesInFlight);
+    if (FramesInFlightCount != m_FramesInFlightCount)
+    {
+        const bool bRecreate = m_FramesInFlight[0].Fence != VK_NULL_HANDLE;
+        if (bRecreate)
+        {
+            FlushGPUCommandsAndWait();
+            DestroyFramesInFlight();
+        }
+
+        m_FramesInFlightCount = FramesInFlightCount;
+        IELOG_CATEGORY_INFO(Renderer, "Frames in flight set to %u", m_FramesInFlightCount);
+
+        if (bRecreate)
+        {
+            CreateFramesInFlight();
+            if (!m_bWindowResourcesReleased)
             {
-                if (vkResetCommandPool(m_VkDevice, VulkanFrame.CommandPool, 0) == VkResult::VK_SUCCESS) // TODO Magic Number
-                {
-                    VkCommandBufferBeginInfo CommandBufferBeginInfo = {};
-                    CommandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-                    CommandBufferBeginInfo.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-                    if (vkBeginCommandBuffer(VulkanFrame.CommandBuffer, &CommandBufferBeginInfo) == VkResult::VK_SUCCESS)
-                    {
-                        VkRenderPassBeginInfo RenderPassBeginInfo = {};
-                        RenderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-                        RenderPassBeginInfo.renderPass = m_AppWindowVulkanData.RenderPass;
-                        RenderPassBeginInfo.framebuffer = VulkanFrame.Framebuffer;
-                        RenderPassBeginInfo.renderArea.extent.width = m_AppWindowVulkanData.Width;
-                        RenderPassBeginInfo.renderArea.extent.height = m_AppWindowVulkanData.Height;
-                        RenderPassBeginInfo.pClearValues = &m_AppWindowVulkanData.ClearValue;
-                        RenderPassBeginInfo.clearValueCount = 1; // TODO Magic Number
-
-                        vkCmdBeginRenderPass(VulkanFrame.CommandBuffer, &RenderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-                        ImGui_ImplVulkan_RenderDrawData(&DrawData, VulkanFrame.CommandBuffer);
-                        vkCmdEndRenderPass(VulkanFrame.CommandBuffer);
-
-                        VkPipelineStageFlags PipelineStageFlags = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-                        VkSubmitInfo SubmitInfo = {};
-                        SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-                        SubmitInfo.waitSemaphoreCount = 1;
-                        SubmitInfo.pWaitSemaphores = &ImageAcquiredSemaphore;
-                        SubmitInfo.pWaitDstStageMask = &PipelineStageFlags;
-                        SubmitInfo.commandBufferCount = 1; // TODO Magic Number
-                        SubmitInfo.pCommandBuffers = &VulkanFrame.CommandBuffer;
-                        SubmitInfo.signalSemaphoreCount = 1; // TODO Magic Number
-                        SubmitInfo.pSignalSemaphores = &RenderCompleteSemaphore;
-
-                        if (vkEndCommandBuffer(VulkanFrame.CommandBuffer) == VkResult::VK_SUCCESS)
-                        {
-                            vkQueueSubmit(m_VkQueue, 1, &SubmitInfo, VulkanFrame.Fence);
-                        }
-                    }
-                }
+                CreateTimestampQueryPool();
             }
         }
     }
 }
 
-void IERenderer_Vulkan::PresentFrame()
+void IERenderer_Vulkan::ReleaseUnusedImGuiFrameResources()
 {
-    if (!m_SwapChainRebuild)
+    // ImGui_ImplVulkanH_CreateOrResizeWindow creates a command pool, command buffer, fence and image acquired semaphore per swapchain
+    // image for its own frame loop, frames in flight replace them. The empty pools stay, ImGui frees its command buffers through them.
+    for (int FrameIndex = 0; FrameIndex < m_AppWindowVulkanData.Frames.Size; FrameIndex++)
     {
-        const VkSemaphore RenderCompleteSemaphore = m_AppWindowVulkanData.FrameSemaphores[m_AppWindowVulkanData.SemaphoreIndex].RenderCompleteSemaphore;
+        ImGui_ImplVulkanH_Frame& Frame = m_AppWindowVulkanData.Frames[FrameIndex];
+        if (Frame.CommandBuffer)
+        {
+            vkFreeCommandBuffers(m_VkDevice, Frame.CommandPool, 1, &Frame.CommandBuffer);
+            Frame.CommandBuffer = VK_NULL_HANDLE;
+            vkResetCommandPool(m_VkDevice, Frame.CommandPool, VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT);
+        }
+        vkDestroyFence(m_VkDevice, Frame.Fence, m_VkAllocationCallback);
+        Frame.Fence = VK_NULL_HANDLE;
+    }
+    for (int SemaphoreIndex = 0; SemaphoreIndex < m_AppWindowVulkanData.FrameSemaphores.Size; SemaphoreIndex++)
+    {
+        ImGui_ImplVulkanH_FrameSemaphores& FrameSemaphores = m_AppWindowVulkanData.FrameSemaphores[SemaphoreIndex];
+        vkDestroySemaphore(m_VkDevice, FrameSemaphores.ImageAcquiredSemaphore, m_VkAllocationCallback);
+        FrameSemaphores.ImageAcquiredSemaphore = VK_NULL_HANDLE;
+    }
+}
 
-        VkPresentInfoKHR PresentInfoKHR = {};
-        PresentInfoKHR.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        PresentInfoKHR.waitSemaphoreCount = 1; // TODO Magic Number
-        PresentInfoKHR.pWaitSemaphores = &RenderCompleteSemaphore;
-        PresentInfoKHR.swapchainCount = 1; // TODO Magic Number
-        PresentInfoKHR.pSwapchains = &m_AppWindowVulkanData.Swapchain;
-        PresentInfoKHR.pImageIndices = &m_AppWindowVulkanData.FrameIndex;
+bool IERenderer_Vulkan::CreateFramesInFlight()
+{
+    bool bCreated = true;
+    for (uint32_t FrameInFlightIndex = 0; FrameInFlightIndex < m_FramesInFlightCount && bCreated; FrameInFlightIndex++)
+    {
+        FrameInFlight& InFlightFrame = m_FramesInFlight[FrameInFlightIndex];
+
+        VkCommandPoolCreateInfo CommandPoolCreateInfo = {};
+        CommandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        CommandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        CommandPoolCreateInfo.queueFamilyIndex = m_QueueFamilyIndex;
+        bCreated = vkCreateCommandPool(m_VkDevice, &CommandPoolCreateInfo, m_VkAllocationCallback, &InFlightFrame.CommandPool) == VkResult::VK_SUCCESS;
+        if (bCreated)
+        {
+            VkCommandBufferAllocateInfo CommandBufferAllocateInfo = {};
+            CommandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            CommandBufferAllocateInfo.commandPool = InFlightFrame.CommandPool;
+            CommandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            CommandBufferAllocateInfo.commandBufferCount = 1;
+            bCreated = vkAllocateCommandBuffers(m_VkDevice, &CommandBufferAllocateInfo, &InFlightFrame.CommandBuffer) == VkResult::VK_SUCCESS;
+        }
+        if (bCreated)
+        {
+            // Created signaled so the first wait on every slot returns immediately
+            VkFenceCreateInfo FenceCreateInfo = {};
+            FenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            FenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+            bCreated = vkCreateFence(m_VkDevice, &FenceCreateInfo, m_VkAllocationCallback, &InFlightFrame.Fence) == VkResult::VK_SUCCESS;
+        }
+        if (bCreated)
+        {
+            VkSemaphoreCreateInfo SemaphoreCreateInfo = {};
+            SemaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            bCreated = vkCreateSemaphore(m_VkDevice, &SemaphoreCreateInfo, m_VkAllocationCallback, &InFlightFrame.ImageAcquiredSemaphore) == VkResult::VK_SUCCESS;
+        }
+    }
+    m_FrameInFlightIndex = 0;
+
+    if (!bCreated)
+    {
+        IELOG_CATEGORY_ERROR(Renderer, "Failed to create %u frames in flight", m_FramesInFlightCount);
+        DestroyFramesInFlight();
+    }
+    return bCreated;
+}
 
-        const VkResult Result = vkQueuePresentKHR(m_VkQueue, &PresentInfoKHR);
-        if (Result == VK_ERROR_OUT_OF_DATE_KHR || Result == VK_SUBOPTIMAL_KHR)
+void IERenderer_Vulkan::DestroyFramesInFlight()
+{
+    for (FrameInFlight& InFlightFrame : m_FramesInFlight)
+    {
+        if (InFlightFrame.ImageAcquiredSemaphore)
         {
-            m_SwapChainRebuild = true;
+            vkDestroySemaphore(m_VkDevice, InFlightFrame.ImageAcquiredSemaphore, m_VkAllocationCallback);
+        }
+        if (InFlightFrame.Fence)
+        {
+            vkDestroyFence(m_VkDevice, InFlightFrame.Fence, m_VkAllocationCallback);
+        }
+        if (InFlightFrame.CommandPool)
+        {
+            // Also frees the command buffer
+            vkDestroyCommandPool(m_VkDevice, InFlightFrame.CommandPool, m_VkAllocationCallback);
+        }
+        InFlightFrame = FrameInFlight();
+    }
+}
+
+void IERenderer_Vulkan::CreateTimestampQueryPool()
+{
+    DestroyTimestampQueryPool();
+
+    // Two timestamps per frame in flight slot, software implementations such as lavapipe expose them as well
+    VkPhysicalDeviceProperties PhysicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(m_VkPhysicalDevice, &PhysicalDeviceProperties);
+
+    uint32_t QueueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_VkPhysicalDevice, &QueueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> QueueFamilyProperties(QueueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_VkPhysicalDevice, &QueueFamilyCount, QueueFamilyProperties.data());
+
+    const uint32_t TimestampValidBits = m_QueueFamilyIndex < QueueFamilyCount ? QueueFamilyProperties[m_QueueFamilyIndex].timestampValidBits : 0;
+    if (TimestampValidBits > 0 && PhysicalDeviceProperties.limits.timestampPeriod > 0.0f && m_FramesInFlightCount > 0)
+    {
+        VkQueryPoolCreateInfo QueryPoolCreateInfo = {};
+        QueryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        QueryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        QueryPoolCreateInfo.queryCount = m_FramesInFlightCount * 2;
+        if (vkCreateQueryPool(m_VkDevice, &QueryPoolCreateInfo, m_VkAllocationCallback, &m_VkTimestampQueryPool) == VkResult::VK_SUCCESS)
+        {
+            m_TimestampPeriodNs = PhysicalDeviceProperties.limits.timestampPeriod;
+            m_TimestampValidMask = TimestampValidBits >= 64 ? ~0ull : ((1ull << TimestampValidBits) - 1);
+            m_TimestampQueryWritten.assign(m_FramesInFlightCount, false);
         }
         else
         {
-            m_AppWindowVulkanData.SemaphoreIndex = (m_AppWindowVulkanData.SemaphoreIndex + 1) % m_AppWindowVulkanData.SemaphoreCount;
+            m_VkTimestampQueryPool = VK_NULL_HANDLE;
+        }
+    }
+    else
+    {
+        IELOG_CATEGORY_WARNING_ONCE(Renderer, "Timestamp queries are not supported, GPU timings are unavailable");
+    }
+}
+
+void IERenderer_Vulkan::DestroyTimestampQueryPool()
+{
+    if (m_VkTimestampQueryPool)
+    {
+        vkDestroyQueryPool(m_VkDevice, m_VkTimestampQueryPool, m_VkAllocationCallback);
+        m_VkTimestampQueryPool = VK_NULL_HANDLE;
+    }
+    m_TimestampQueryWritten.clear();
+}
+
+void IERenderer_Vulkan::WriteTimestampQuery(VkCommandBuffer CommandBuffer, uint32_t FrameIndex, VkPipelineStageFlagBits PipelineStage)
+{
+    if (m_VkTimestampQueryPool && FrameIndex < m_TimestampQueryWritten.size())
+    {
+        const bool bIsBeginQuery = PipelineStage == VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        if (bIsBeginQuery)
+        {
+            vkCmdResetQueryPool(CommandBuffer, m_VkTimestampQueryPool, FrameIndex * 2, 2);
+        }
+        vkCmdWriteTimestamp(CommandBuffer, PipelineStage, m_VkTimestampQueryPool, FrameIndex * 2 + (bIsBeginQuery ? 0 : 1));
+        m_TimestampQueryWritten[FrameIndex] = !bIsBeginQuery;
+    }
+}
+
+void IERenderer_Vulkan::CollectTimestampQueries(uint32_t FrameIndex)
+{
+    // Called once the frame slot fence has signaled, so the queries from its previous use are complete and reading never stalls
+    if (m_VkTimestampQueryPool && FrameIndex < m_TimestampQueryWritten.size() && m_TimestampQueryWritten[FrameIndex])
+    {
+        uint64_t Timestamps[2] = {};
+        if (vkGetQueryPoolResults(m_VkDevice, m_VkTimestampQueryPool, FrameIndex * 2, 2, sizeof(Timestamps), Timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VkResult::VK_SUCCESS)
+        {
+            const uint64_t ElapsedTicks = ((Timestamps[1] & m_TimestampValidMask) - (Timestamps[0] & m_TimestampValidMask)) & m_TimestampValidMask;
+            m_FrameProfiler.SetGPUFrameDuration(static_cast<int64_t>(static_cast<double>(ElapsedTicks) * m_TimestampPeriodNs));
         }
+        m_TimestampQueryWritten[FrameIndex] = false;
     }
 }
 
@@ -523,142 +1748,534 @@ void IERenderer_Vulkan::GlfwErrorCallbackFunc(int ErrorCode, const char* Descrip
 
 IEResult IERenderer_Vulkan::InitializeVulkan()
 {
-    IEResult Result(IEResult::Type::Fail, "Failed to initialize Vulkan");
+    const IEClock::time_point StartTime = IEClock::now();
+    const IEResult Result = NegotiateInstanceExtensions()
+        .and_then([this](std::vector<const char*> InstanceExtensionNames)
+            {
+                m_EnabledInstanceExtensionNames = std::move(InstanceExtensionNames);
+                return CreateInstance();
+            })
+        .and_then([this](VkInstance Instance)
+            {
+                m_VkInstance = Instance;
+                return SelectPhysicalDevice();
+            })
+        .and_then([this](VkPhysicalDevice PhysicalDevice)
+            {
+                m_VkPhysicalDevice = PhysicalDevice;
+                return FindGraphicsQueueFamilyIndex();
+            })
+        .and_then([this](uint32_t QueueFamilyIndex)
+            {
+                m_QueueFamilyIndex = QueueFamilyIndex;
+                return NegotiateDeviceExtensions();
+            })
+        .and_then([this](std::vector<const char*> DeviceExtensionNames)
+            {
+                m_EnabledDeviceExtensionNames = std::move(DeviceExtensionNames);
+                return CreateDevice();
+            })
+        .and_then([this](VkDevice Device)
+            {
+                m_VkDevice = Device;
+                vkGetDeviceQueue(m_VkDevice, m_QueueFamilyIndex, 0, &m_VkQueue);
+                return CreateDescriptorPool();
+            })
+        .transform([this](VkDescriptorPool DescriptorPool)
+            {
+                m_VkDescriptorPool = DescriptorPool;
+                return DescriptorPool;
+            })
+        .ToResult("Successfully initialized Vulkan");
 
+    if (Result.Type == IEResult::Type::Success)
+    {
+        IELOG_CATEGORY_INFO(Renderer, "Initialized Vulkan in %.2f ms with %u instance and %u device extensions",
+            std::chrono::duration<double, std::milli>(IEClock::now() - StartTime).count(),
+            static_cast<uint32_t>(m_EnabledInstanceExtensionNames.size()), static_cast<uint32_t>(m_EnabledDeviceExtensionNames.size()));
+    }
+    return Result;
+}
+
+IEExpected<std::vector<const char*>> IERenderer_Vulkan::NegotiateInstanceExtensions() const
+{
     uint32_t InstanceExtensionCount = 0;
     vkEnumerateInstanceExtensionProperties(nullptr, &InstanceExtensionCount, nullptr);
     std::vector<VkExtensionProperties> InstanceExtensionProperties(InstanceExtensionCount);
-    if (vkEnumerateInstanceExtensionProperties(nullptr, &InstanceExtensionCount, InstanceExtensionProperties.data()) == VkResult::VK_SUCCESS)
+    if (vkEnumerateInstanceExtensionProperties(nullptr, &InstanceExtensionCount, InstanceExtensionProperties.data()) != VkResult::VK_SUCCESS)
     {
-        std::vector<const char*> InstanceExtensionNames(InstanceExtensionCount);
-        for (uint32_t i = 0; i < InstanceExtensionCount; i++)
+        return IEResult(IEResult::Type::Fail, "Failed to enumerate instance extensions");
+    }
+
+    // GLFW reports the surface extensions of the current platform, the strings stay valid until glfwTerminate
+    uint32_t RequiredInstanceExtensionCount = 0;
+    const char** const RequiredInstanceExtensions = glfwGetRequiredInstanceExtensions(&RequiredInstanceExtensionCount);
+    if (!RequiredInstanceExtensions)
+    {
+        return IEResult(IEResult::Type::NotSupported, "GLFW found no Vulkan surface support");
+    }
+
+    std::vector<const char*> InstanceExtensionNames;
+    for (uint32_t i = 0; i < RequiredInstanceExtensionCount; i++)
+    {
+        if (!HasExtension(InstanceExtensionProperties, RequiredInstanceExtensions[i]))
+        {
+            IELOG_CATEGORY_ERROR(Renderer, "Missing required instance extension %s", RequiredInstanceExtensions[i]);
+            return IEResult(IEResult::Type::NotSupported, "Missing a required instance extension");
+        }
+        InstanceExtensionNames.push_back(RequiredInstanceExtensions[i]);
+    }
+    for (const char* OptionalInstanceExtension : OptionalInstanceExtensions)
+    {
+        if (HasExtension(InstanceExtensionProperties, OptionalInstanceExtension))
         {
-            InstanceExtensionNames[i] = InstanceExtensionProperties[i].extensionName;
+            InstanceExtensionNames.push_back(OptionalInstanceExtension);
         }
+    }
+    for (const char* InstanceExtensionName : InstanceExtensionNames)
+    {
+        IELOG_CATEGORY_INFO(Renderer, "Enabling instance extension %s", InstanceExtensionName);
+    }
+    return InstanceExtensionNames;
+}
+
+IEExpected<VkInstance> IERenderer_Vulkan::CreateInstance() const
+{
+    VkInstanceCreateInfo InstanceCreateInfo = {};
+    InstanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    InstanceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(m_EnabledInstanceExtensionNames.size());
+    InstanceCreateInfo.ppEnabledExtensionNames = m_EnabledInstanceExtensionNames.data();
+    if (IsInstanceExtensionEnabled(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME))
+    {
+        InstanceCreateInfo.flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
+    }
 
-        VkInstanceCreateInfo InstanceCreateInfo = {};
-        InstanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
-        InstanceCreateInfo.enabledExtensionCount = InstanceExtensionCount;
-        InstanceCreateInfo.ppEnabledExtensionNames = InstanceExtensionNames.data();
+    VkInstance Instance = nullptr;
+    if (vkCreateInstance(&InstanceCreateInfo, m_VkAllocationCallback, &Instance) != VkResult::VK_SUCCESS)
+    {
+        return IEResult(IEResult::Type::Fail, "Failed to create Vulkan instance");
+    }
+    return Instance;
+}
+
+IEExpected<VkPhysicalDevice> IERenderer_Vulkan::SelectPhysicalDevice() const
+{
+    uint32_t PhysicalDeviceCount = 0;
+    vkEnumeratePhysicalDevices(m_VkInstance, &PhysicalDeviceCount, nullptr);
+    std::vector<VkPhysicalDevice> PhysicalDevices(PhysicalDeviceCount);
+    if (vkEnumeratePhysicalDevices(m_VkInstance, &PhysicalDeviceCount, PhysicalDevices.data()) != VkResult::VK_SUCCESS || PhysicalDevices.empty())
+    {
+        return IEResult(IEResult::Type::NotSupported, "Failed to find a Vulkan physical device");
+    }
+
+    // IE_VULKAN_DEVICE=<index or part of the device name> pins a device, e.g. llvmpipe to run on lavapipe
+    const char* const DeviceOverride = std::getenv("IE_VULKAN_DEVICE");
+
+    VkPhysicalDevice SelectedPhysicalDevice = nullptr;
+    VkPhysicalDevice OverridePhysicalDevice = nullptr;
+    int64_t SelectedScore = -1;
+    for (uint32_t PhysicalDeviceIndex = 0; PhysicalDeviceIndex < PhysicalDeviceCount; PhysicalDeviceIndex++)
+    {
+        VkPhysicalDevice PhysicalDevice = PhysicalDevices[PhysicalDeviceIndex];
+        VkPhysicalDeviceProperties PhysicalDeviceProperties;
+        vkGetPhysicalDeviceProperties(PhysicalDevice, &PhysicalDeviceProperties);
+
+        const int64_t Score = ScorePhysicalDevice(PhysicalDevice);
+        IELOG_CATEGORY_INFO(Renderer, "Found %s (index %u, score %lld)", PhysicalDeviceProperties.deviceName, PhysicalDeviceIndex, static_cast<long long>(Score));
 
-        for (const char* InstanceExtensionName : InstanceExtensionNames)
+        if (Score >= 0 && DeviceOverride && !OverridePhysicalDevice)
         {
-            if (std::strcmp(InstanceExtensionName, VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME) == 0)
+            std::string DeviceName = PhysicalDeviceProperties.deviceName;
+            std::string DeviceOverrideName = DeviceOverride;
+            std::transform(DeviceName.begin(), DeviceName.end(), DeviceName.begin(), [](unsigned char Character) { return static_cast<char>(std::tolower(Character)); });
+            std::transform(DeviceOverrideName.begin(), DeviceOverrideName.end(), DeviceOverrideName.begin(), [](unsigned char Character) { return static_cast<char>(std::tolower(Character)); });
+            if (DeviceOverrideName == std::to_string(PhysicalDeviceIndex) || (!DeviceOverrideName.empty() && DeviceName.find(DeviceOverrideName) != std::string::npos))
             {
-                InstanceCreateInfo.flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
-                break;
+                OverridePhysicalDevice = PhysicalDevice;
             }
         }
+        if (Score > SelectedScore)
+        {
+            SelectedPhysicalDevice = PhysicalDevice;
+            SelectedScore = Score;
+        }
+    }
 
-        if (vkCreateInstance(&InstanceCreateInfo, m_VkAllocationCallback, &m_VkInstance) == VkResult::VK_SUCCESS)
+    if (DeviceOverride)
+    {
+        if (OverridePhysicalDevice)
         {
-            if (InitializeInstancePhysicalDevice())
-            {
-                uint32_t QueueFamilyCount = 0;
-                vkGetPhysicalDeviceQueueFamilyProperties(m_VkPhysicalDevice, &QueueFamilyCount, nullptr);
-                std::vector<VkQueueFamilyProperties> QueueFamilyProperties(QueueFamilyCount);
-                vkGetPhysicalDeviceQueueFamilyProperties(m_VkPhysicalDevice, &QueueFamilyCount, QueueFamilyProperties.data());
+            SelectedPhysicalDevice = OverridePhysicalDevice;
+        }
+        else
+        {
+            IELOG_CATEGORY_WARNING(Renderer, "IE_VULKAN_DEVICE=%s matches no suitable device, using the highest scored one", DeviceOverride);
+        }
+    }
 
-                m_QueueFamilyIndex = static_cast<uint32_t>(-1);
-                for (uint32_t i = 0; i < QueueFamilyCount; i++)
-                {
-                    if (QueueFamilyProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
-                    {
-                        m_QueueFamilyIndex = i;
-                        break;
-                    }
-                }
+    if (!SelectedPhysicalDevice)
+    {
+        return IEResult(IEResult::Type::NotSupported, "Failed to find a Vulkan physical device that can present with the required extensions");
+    }
 
-                if (m_QueueFamilyIndex != static_cast<uint32_t>(-1))
-                {
-                    uint32_t DeviceExtensionCount = 0;
-                    vkEnumerateDeviceExtensionProperties(m_VkPhysicalDevice, nullptr, &DeviceExtensionCount, nullptr);
-                    std::vector<VkExtensionProperties> DeviceExtensionProperties(DeviceExtensionCount);
-                    vkEnumerateDeviceExtensionProperties(m_VkPhysicalDevice, nullptr, &DeviceExtensionCount, DeviceExtensionProperties.data());
+    VkPhysicalDeviceProperties SelectedPhysicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(SelectedPhysicalDevice, &SelectedPhysicalDeviceProperties);
+    IELOG_CATEGORY_INFO(Renderer, "Using physical device %s", SelectedPhysicalDeviceProperties.deviceName);
+    return SelectedPhysicalDevice;
+}
 
-                    std::vector<const char*> DeviceExtensionNames(DeviceExtensionCount);
-                    for (uint32_t i = 0; i < DeviceExtensionCount; i++)
-                    {
-                        DeviceExtensionNames[i] = DeviceExtensionProperties[i].extensionName;
-                    }
+int64_t IERenderer_Vulkan::ScorePhysicalDevice(VkPhysicalDevice PhysicalDevice) const
+{
+    // Devices that cannot present from a graphics queue or lack a required extension are unsuitable
+    const std::optional<uint32_t> QueueFamilyIndex = FindGraphicsPresentQueueFamilyIndex(PhysicalDevice);
+    const std::vector<VkExtensionProperties> DeviceExtensionProperties = EnumerateDeviceExtensionProperties(PhysicalDevice);
+    if (!QueueFamilyIndex.has_value() || !std::all_of(RequiredDeviceExtensions.begin(), RequiredDeviceExtensions.end(),
+        [&DeviceExtensionProperties](const char* ExtensionName) { return HasExtension(DeviceExtensionProperties, ExtensionName); }))
+    {
+        return -1;
+    }
 
-                    VkDeviceQueueCreateInfo DeviceQueueCreateInfo = {};
-                    DeviceQueueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-                    DeviceQueueCreateInfo.queueFamilyIndex = m_QueueFamilyIndex;
-                    DeviceQueueCreateInfo.queueCount = 1; // TODO Magic Number
-                    float QueuePriority = 1.0f; // TODO Magic Number
-                    DeviceQueueCreateInfo.pQueuePriorities = &QueuePriority;
-
-                    VkDeviceCreateInfo DeviceCreateInfo = {};
-                    DeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-                    DeviceCreateInfo.queueCreateInfoCount = 1; // TODO Magic Number
-                    DeviceCreateInfo.pQueueCreateInfos = &DeviceQueueCreateInfo;
-                    DeviceCreateInfo.enabledExtensionCount = (uint32_t)DeviceExtensionCount;
-                    DeviceCreateInfo.ppEnabledExtensionNames = DeviceExtensionNames.data();
-
-                    if (vkCreateDevice(m_VkPhysicalDevice, &DeviceCreateInfo, m_VkAllocationCallback, &m_VkDevice) == VkResult::VK_SUCCESS)
-                    {
-                        vkGetDeviceQueue(m_VkDevice, m_QueueFamilyIndex, 0, &m_VkQueue);
+    VkPhysicalDeviceProperties PhysicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(PhysicalDevice, &PhysicalDeviceProperties);
 
-                        VkDescriptorPoolCreateInfo DescriptorPoolCreateInfo = {};
-                        DescriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-                        DescriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-                        DescriptorPoolCreateInfo.maxSets = 1; // TODO Magic Number
-                        DescriptorPoolCreateInfo.poolSizeCount = 1; // TODO Magic Number
+    int64_t Score = 0;
+    switch (PhysicalDeviceProperties.deviceType)
+    {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: Score += 1000; break;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: Score += 500; break;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: Score += 200; break;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU: Score += 10; break;
+    default: break;
+    }
 
-                        VkDescriptorPoolSize DescriptorPoolSize = {};
-                        DescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-                        DescriptorPoolSize.descriptorCount = 1; // TODO Magic Number
+    // GPU timings need timestamps on the queue
+    uint32_t QueueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(PhysicalDevice, &QueueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> QueueFamilyProperties(QueueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(PhysicalDevice, &QueueFamilyCount, QueueFamilyProperties.data());
+    if (QueueFamilyProperties[QueueFamilyIndex.value()].timestampValidBits > 0)
+    {
+        Score += 20;
+    }
 
-                        DescriptorPoolCreateInfo.pPoolSizes = &DescriptorPoolSize;
+    // One point per GiB of device local memory, capped so memory never outweighs the device type
+    VkPhysicalDeviceMemoryProperties MemoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(PhysicalDevice, &MemoryProperties);
+    VkDeviceSize DeviceLocalBytes = 0;
+    for (uint32_t HeapIndex = 0; HeapIndex < MemoryProperties.memoryHeapCount; HeapIndex++)
+    {
+        if (MemoryProperties.memoryHeaps[HeapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+        {
+            DeviceLocalBytes += MemoryProperties.memoryHeaps[HeapIndex].size;
+        }
+    }
+    Score += std::min<int64_t>(static_cast<int64_t>(DeviceLocalBytes >> 30), 64);
 
-                        if (vkCreateDescriptorPool(m_VkDevice, &DescriptorPoolCreateInfo, m_VkAllocationCallback, &m_VkDescriptorPool) == VkResult::VK_SUCCESS)
-                        {
-                            Result.Type = IEResult::Type::Success;
-                            Result.Message = "Successfully initialized Vulkan";
-                        }
-                    }
-                }
-            }
+    for (const char* OptionalDeviceExtension : OptionalDeviceExtensions)
+    {
+        if (HasExtension(DeviceExtensionProperties, OptionalDeviceExtension))
+        {
+            Score += 5;
         }
     }
-    return Result;
+    return Score;
 }
 
-IEResult IERenderer_Vulkan::InitializeInstancePhysicalDevice()
+std::optional<uint32_t> IERenderer_Vulkan::FindGraphicsPresentQueueFamilyIndex(VkPhysicalDevice PhysicalDevice) const
 {
-    IEResult Result(IEResult::Type::Fail, "Failed to initialize instance physical device");
+    uint32_t QueueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(PhysicalDevice, &QueueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> QueueFamilyProperties(QueueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(PhysicalDevice, &QueueFamilyCount, QueueFamilyProperties.data());
 
-    uint32_t PhysicalDeviceCount = 0;
-    vkEnumeratePhysicalDevices(m_VkInstance, &PhysicalDeviceCount, nullptr);
-    std::vector<VkPhysicalDevice> PhysicalDevices(PhysicalDeviceCount);
-    if (vkEnumeratePhysicalDevices(m_VkInstance, &PhysicalDeviceCount, PhysicalDevices.data()) == VkResult::VK_SUCCESS)
+    // Frames are submitted and presented from the same queue, the surface does not exist yet so GLFW answers for the platform
+    for (uint32_t i = 0; i < QueueFamilyCount; i++)
     {
-        m_VkPhysicalDevice = PhysicalDevices[0];
-        Result.Type = IEResult::Type::Success;
-        Result.Message = "Using integrated device";
-
-        for (VkPhysicalDevice& PhysicalDevice : PhysicalDevices)
+        if ((QueueFamilyProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) && glfwGetPhysicalDevicePresentationSupport(m_VkInstance, PhysicalDevice, i) == GLFW_TRUE)
         {
-            VkPhysicalDeviceProperties PhysicalDeviceProperties;
-            vkGetPhysicalDeviceProperties(PhysicalDevice, &PhysicalDeviceProperties);
-            IELOG_INFO("Found %s", PhysicalDeviceProperties.deviceName);
+            return i;
+        }
+    }
+    return std::nullopt;
+}
 
-            if (PhysicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
-            {
-                m_VkPhysicalDevice = PhysicalDevice;
-                Result.Type = IEResult::Type::Success;
-                Result.Message = std::format("Using physical device {}", PhysicalDeviceProperties.deviceName);
-                break;
-            }
+IEExpected<uint32_t> IERenderer_Vulkan::FindGraphicsQueueFamilyIndex() const
+{
+    const std::optional<uint32_t> QueueFamilyIndex = FindGraphicsPresentQueueFamilyIndex(m_VkPhysicalDevice);
+    if (!QueueFamilyIndex.has_value())
+    {
+        return IEResult(IEResult::Type::NotSupported, "Failed to find a graphics queue family");
+    }
+    return QueueFamilyIndex.value();
+}
+
+IEExpected<std::vector<const char*>> IERenderer_Vulkan::NegotiateDeviceExtensions() const
+{
+    const std::vector<VkExtensionProperties> DeviceExtensionProperties = EnumerateDeviceExtensionProperties(m_VkPhysicalDevice);
+
+    std::vector<const char*> DeviceExtensionNames;
+    for (const char* RequiredDeviceExtension : RequiredDeviceExtensions)
+    {
+        if (!HasExtension(DeviceExtensionProperties, RequiredDeviceExtension))
+        {
+            IELOG_CATEGORY_ERROR(Renderer, "Missing required device extension %s", RequiredDeviceExtension);
+            return IEResult(IEResult::Type::NotSupported, "Missing a required device extension");
         }
+        DeviceExtensionNames.push_back(RequiredDeviceExtension);
     }
-    return Result;
+    for (const char* OptionalDeviceExtension : OptionalDeviceExtensions)
+    {
+        // The memory budget query also needs vkGetPhysicalDeviceMemoryProperties2 from the instance
+        const bool bUsable = std::strcmp(OptionalDeviceExtension, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) != 0 ||
+            IsInstanceExtensionEnabled(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+        if (bUsable && HasExtension(DeviceExtensionProperties, OptionalDeviceExtension))
+        {
+            DeviceExtensionNames.push_back(OptionalDeviceExtension);
+        }
+    }
+    for (const char* DeviceExtensionName : DeviceExtensionNames)
+    {
+        IELOG_CATEGORY_INFO(Renderer, "Enabling device extension %s", DeviceExtensionName);
+    }
+    return DeviceExtensionNames;
+}
+
+IEExpected<VkDevice> IERenderer_Vulkan::CreateDevice() const
+{
+    VkDeviceQueueCreateInfo DeviceQueueCreateInfo = {};
+    DeviceQueueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    DeviceQueueCreateInfo.queueFamilyIndex = m_QueueFamilyIndex;
+    DeviceQueueCreateInfo.queueCount = 1; // TODO Magic Number
+    float QueuePriority = 1.0f; // TODO Magic Number
+    DeviceQueueCreateInfo.pQueuePriorities = &QueuePriority;
+
+    VkDeviceCreateInfo DeviceCreateInfo = {};
+    DeviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    DeviceCreateInfo.queueCreateInfoCount = 1; // TODO Magic Number
+    DeviceCreateInfo.pQueueCreateInfos = &DeviceQueueCreateInfo;
+    DeviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(m_EnabledDeviceExtensionNames.size());
+    DeviceCreateInfo.ppEnabledExtensionNames = m_EnabledDeviceExtensionNames.data();
+
+    VkDevice Device = nullptr;
+    if (vkCreateDevice(m_VkPhysicalDevice, &DeviceCreateInfo, m_VkAllocationCallback, &Device) != VkResult::VK_SUCCESS)
+    {
+        return IEResult(IEResult::Type::Fail, "Failed to create Vulkan device");
+    }
+    return Device;
+}
+
+std::vector<VkExtensionProperties> IERenderer_Vulkan::EnumerateDeviceExtensionProperties(VkPhysicalDevice PhysicalDevice)
+{
+    uint32_t DeviceExtensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(PhysicalDevice, nullptr, &DeviceExtensionCount, nullptr);
+    std::vector<VkExtensionProperties> DeviceExtensionProperties(DeviceExtensionCount);
+    if (vkEnumerateDeviceExtensionProperties(PhysicalDevice, nullptr, &DeviceExtensionCount, DeviceExtensionProperties.data()) != VkResult::VK_SUCCESS)
+    {
+        DeviceExtensionProperties.clear();
+    }
+    return DeviceExtensionProperties;
+}
+
+bool IERenderer_Vulkan::HasExtension(const std::vector<VkExtensionProperties>& ExtensionProperties, const char* ExtensionName)
+{
+    return std::any_of(ExtensionProperties.begin(), ExtensionProperties.end(), [ExtensionName](const VkExtensionProperties& Properties)
+        {
+            return std::strcmp(Properties.extensionName, ExtensionName) == 0;
+        });
+}
+
+bool IERenderer_Vulkan::IsInstanceExtensionEnabled(const char* ExtensionName) const
+{
+    return std::any_of(m_EnabledInstanceExtensionNames.begin(), m_EnabledInstanceExtensionNames.end(), [ExtensionName](const char* EnabledExtensionName)
+        {
+            return std::strcmp(EnabledExtensionName, ExtensionName) == 0;
+        });
+}
+
+bool IERenderer_Vulkan::IsDeviceExtensionEnabled(const char* ExtensionName) const
+{
+    return std::any_of(m_EnabledDeviceExtensionNames.begin(), m_EnabledDeviceExtensionNames.end(), [ExtensionName](const char* EnabledExtensionName)
+        {
+            return std::strcmp(EnabledExtensionName, ExtensionName) == 0;
+        });
+}
+
+IEExpected<VkDescriptorPool> IERenderer_Vulkan::CreateDescriptorPool() const
+{
+    VkDescriptorPoolCreateInfo DescriptorPoolCreateInfo = {};
+    DescriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    DescriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    DescriptorPoolCreateInfo.maxSets = 1; // TODO Magic Number
+    DescriptorPoolCreateInfo.poolSizeCount = 1; // TODO Magic Number
+
+    VkDescriptorPoolSize DescriptorPoolSize = {};
+    DescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    DescriptorPoolSize.descriptorCount = 1; // TODO Magic Number
+
+    DescriptorPoolCreateInfo.pPoolSizes = &DescriptorPoolSize;
+
+    VkDescriptorPool DescriptorPool = nullptr;
+    if (vkCreateDescriptorPool(m_VkDevice, &DescriptorPoolCreateInfo, m_VkAllocationCallback, &DescriptorPool) != VkResult::VK_SUCCESS)
+    {
+        return IEResult(IEResult::Type::Fail, "Failed to create descriptor pool");
+    }
+    return DescriptorPool;
+}
+
+IEExpected<VkSurfaceKHR> IERenderer_Vulkan::CreateWindowSurface() const
+{
+    VkSurfaceKHR Surface = nullptr;
+    if (glfwCreateWindowSurface(m_VkInstance, m_AppWindow, m_VkAllocationCallback, &Surface) != VkResult::VK_SUCCESS)
+    {
+        return IEResult(IEResult::Type::Fail, "Failed to create window surface");
+    }
+
+    VkBool32 PhysicalDeviceSurfaceSupport = false;
+    vkGetPhysicalDeviceSurfaceSupportKHR(m_VkPhysicalDevice, m_QueueFamilyIndex, Surface, &PhysicalDeviceSurfaceSupport);
+    if (PhysicalDeviceSurfaceSupport != VK_TRUE)
+    {
+        vkDestroySurfaceKHR(m_VkInstance, Surface, m_VkAllocationCallback);
+        return IEResult(IEResult::Type::NotSupported, "Physical device is not supported");
+    }
+    return Surface;
 }
 
 void IERenderer_Vulkan::DinitializeVulkan()
 {
+    // The cache contents are copied out here, the file write overlaps the rest of the teardown
+    SavePipelineCache();
+    if (m_VkPipelineCache)
+    {
+        vkDestroyPipelineCache(m_VkDevice, m_VkPipelineCache, m_VkAllocationCallback);
+        m_VkPipelineCache = VK_NULL_HANDLE;
+    }
     vkDestroyDescriptorPool(m_VkDevice, m_VkDescriptorPool, m_VkAllocationCallback);
     vkDestroyDevice(m_VkDevice, m_VkAllocationCallback);
     vkDestroyInstance(m_VkInstance, m_VkAllocationCallback);
+}
+
+std::filesystem::path IERenderer_Vulkan::GetPipelineCachePath() const
+{
+    return IEUtils::GetIEConfigFolderPath() / "PipelineCaches" / std::format("{}.vkpipelinecache", m_AppName);
+}
+
+bool IERenderer_Vulkan::CreatePipelineCache()
+{
+    std::vector<uint8_t> InitialData;
+    if (FILE* const File = std::fopen(GetPipelineCachePath().string().c_str(), "rb"))
+    {
+        if (std::fseek(File, 0, SEEK_END) == 0)
+        {
+            const long FileSize = std::ftell(File);
+            if (FileSize > 0 && std::fseek(File, 0, SEEK_SET) == 0)
+            {
+                InitialData.resize(static_cast<size_t>(FileSize));
+                if (std::fread(InitialData.data(), 1, InitialData.size(), File) != InitialData.size())
+                {
+                    InitialData.clear();
+                }
+            }
+        }
+        std::fclose(File);
+    }
+
+    VkPhysicalDeviceProperties PhysicalDeviceProperties;
+    vkGetPhysicalDeviceProperties(m_VkPhysicalDevice, &PhysicalDeviceProperties);
+    if (!InitialData.empty() && !IsPipelineCacheDataCompatible(InitialData, PhysicalDeviceProperties))
+    {
+        IELOG_CATEGORY_WARNING(Renderer, "Discarding pipeline cache written by another device or driver");
+        InitialData.clear();
+    }
+
+    VkPipelineCacheCreateInfo PipelineCacheCreateInfo = {};
+    PipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    PipelineCacheCreateInfo.initialDataSize = InitialData.size();
+    PipelineCacheCreateInfo.pInitialData = InitialData.data();
+    if (vkCreatePipelineCache(m_VkDevice, &PipelineCacheCreateInfo, m_VkAllocationCallback, &m_VkPipelineCache) != VkResult::VK_SUCCESS && !InitialData.empty())
+    {
+        // The driver still rejected the data, start from an empty cache
+        InitialData.clear();
+        PipelineCacheCreateInfo.initialDataSize = 0;
+        PipelineCacheCreateInfo.pInitialData = nullptr;
+        if (vkCreatePipelineCache(m_VkDevice, &PipelineCacheCreateInfo, m_VkAllocationCallback, &m_VkPipelineCache) != VkResult::VK_SUCCESS)
+        {
+            m_VkPipelineCache = VK_NULL_HANDLE;
+        }
+    }
+
+    m_SavedPipelineCacheSize = InitialData.size();
+    return m_VkPipelineCache && !InitialData.empty();
+}
+
+void IERenderer_Vulkan::SavePipelineCache()
+{
+    size_t DataSize = 0;
+    if (m_VkPipelineCache && vkGetPipelineCacheData(m_VkDevice, m_VkPipelineCache, &DataSize, nullptr) == VkResult::VK_SUCCESS &&
+        DataSize > 0 && DataSize != m_SavedPipelineCacheSize)
+    {
+        std::vector<uint8_t> Data(DataSize);
+        if (vkGetPipelineCacheData(m_VkDevice, m_VkPipelineCache, &DataSize, Data.data()) == VkResult::VK_SUCCESS)
+        {
+            Data.resize(DataSize);
+            m_SavedPipelineCacheSize = DataSize;
+
+            WaitForPipelineCacheSave();
+            m_PipelineCacheSaveTask = std::async(std::launch::async, [Path = GetPipelineCachePath(), Data = std::move(Data)]()
+                {
+                    // Written next to the destination and renamed over it, a crash mid write never leaves a torn cache behind
+                    std::error_code ErrorCode;
+                    std::filesystem::create_directories(Path.parent_path(), ErrorCode);
+                    std::filesystem::path TemporaryPath = Path;
+                    TemporaryPath += ".tmp";
+
+                    bool bSaved = false;
+                    if (FILE* const File = std::fopen(TemporaryPath.string().c_str(), "wb"))
+                    {
+                        bSaved = std::fwrite(Data.data(), 1, Data.size(), File) == Data.size();
+                        bSaved = std::fclose(File) == 0 && bSaved;
+                    }
+                    if (bSaved)
+                    {
+                        std::filesystem::rename(TemporaryPath, Path, ErrorCode);
+                        bSaved = !ErrorCode;
+                    }
+
+                    if (bSaved)
+                    {
+                        IELOG_CATEGORY_INFO(Renderer, "Saved pipeline cache (%llu bytes)", static_cast<unsigned long long>(Data.size()));
+                    }
+                    else
+                    {
+                        std::filesystem::remove(TemporaryPath, ErrorCode);
+                        IELOG_CATEGORY_WARNING(Renderer, "Failed to save pipeline cache to %s", Path.string().c_str());
+                    }
+                });
+        }
+    }
+}
+
+void IERenderer_Vulkan::WaitForPipelineCacheSave()
+{
+    if (m_PipelineCacheSaveTask.valid())
+    {
+        m_PipelineCacheSaveTask.wait();
+    }
+}
+
+bool IERenderer_Vulkan::IsPipelineCacheDataCompatible(const std::vector<uint8_t>& Data, const VkPhysicalDeviceProperties& PhysicalDeviceProperties)
+{
+    // VkPipelineCacheHeaderVersionOne: header size, header version, vendor ID, device ID, then the pipeline cache UUID
+    static constexpr size_t HeaderSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+    bool bCompatible = false;
+    if (Data.size() >= HeaderSize)
+    {
+        uint32_t HeaderFields[4] = {};
+        std::memcpy(HeaderFields, Data.data(), sizeof(HeaderFields));
+        bCompatible = HeaderFields[0] >= HeaderSize &&
+            HeaderFields[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            HeaderFields[2] == PhysicalDeviceProperties.vendorID &&
+            HeaderFields[3] == PhysicalDeviceProperties.deviceID &&
+            std::memcmp(Data.data() + sizeof(HeaderFields), PhysicalDeviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+    return bCompatible;
 }
\ No newline at end of file
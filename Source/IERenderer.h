@@ -21,12 +21,31 @@
 #include "backends/imgui_impl_glfw.h"
 #include "backends/imgui_impl_vulkan.h"
 
+#include "IEDrawDataSnapshot.h"
+#include "IEFrameProfiler.h"
+#include "IEInputLayer.h"
+#include "IELogger.h"
+#include "IERefreshGovernor.h"
 #include "IEUtils.h"
+#include "IEVulkanHostAllocator.h"
+
+// Presentation trade-off between latency, smoothness and power, resolved against what the surface supports.
+enum class IELatencyMode : uint8_t
+{
+    PowerSaving,    // FIFO, 2 images, lowest queue depth while staying vsynced
+    Balanced,       // FIFO_RELAXED, 3 images, a late frame tears instead of waiting a whole refresh
+    LowLatency,     // MAILBOX, 3 images, the newest frame replaces the queued one, no tearing
+    Uncapped,       // IMMEDIATE, 2 images, presents as soon as possible and may tear
+    Count
+};
+
+const char* GetIELatencyModeName(IELatencyMode LatencyMode);
 
 class IERenderer
 {
 public:
     using IEWindowCallbackFunc = std::function<void(uint32_t WindowID)>;
+    using IEBackgroundTickFunc = std::function<void()>;
 
 public:
     virtual ~IERenderer() = default;
@@ -42,6 +61,22 @@ public:
     virtual void RenderFrame(ImDrawData& DrawData) = 0;
     virtual void PresentFrame() = 0;
 
+    // RenderFrame then only snapshots the ImDrawData and a render thread acquires, records, submits and presents it,
+    // so the UI thread builds frame N+1 while frame N is recorded and on the GPU. Can be toggled at any time.
+    virtual void SetRenderThreadEnabled(bool bEnabled) = 0;
+    virtual bool IsRenderThreadEnabled() const = 0;
+    // Number of frames the CPU may record ahead of the GPU, 1 to 3, independent of the swapchain image count.
+    // Fewer frames lower latency, more frames absorb CPU and GPU spikes. Changing it waits for the GPU to go idle.
+    virtual void SetFramesInFlight(uint32_t Count) = 0;
+    virtual uint32_t GetFramesInFlight() const = 0;
+    // Picks the present mode and swapchain image count, switching at runtime rebuilds the swapchain on the next frame.
+    // Unsupported present modes fall back towards FIFO, which every surface supports.
+    virtual void SetLatencyMode(IELatencyMode LatencyMode) = 0;
+    virtual IELatencyMode GetLatencyMode() const = 0;
+    // Routes the graphics API's host allocations through a pooling allocator that tracks live and peak bytes per allocation scope,
+    // shown in the detailed telemetry. Only takes effect when set before Initialize.
+    virtual void SetHostAllocatorEnabled(bool bEnabled) = 0;
+
 public:
     void PostWindowCreated();
     void RequestExit();
@@ -51,9 +86,37 @@ public:
     void PollEvents() const;
     void PostEmptyEvent() const;
 
+    /* Frame Admission */
+    // False while the app window is closed, iconified, hidden or zero sized, the loop should then skip NewFrame,
+    // ImGui::NewFrame, ImGui::Render, RenderFrame and PresentFrame and call WaitForBackgroundTick instead.
+    bool AdmitFrame();
+    void AddBackgroundTickCallbackFunc(std::chrono::nanoseconds Interval, const IEBackgroundTickFunc& Func);
+    // Runs due background ticks, then waits for events until the next one, or indefinitely when none is registered.
+    void WaitForBackgroundTick();
+
+    /* Redraw Scheduling */
+    // Thread safe, wakes the loop through PostEmptyEvent when the new deadline is the earliest one.
+    void RequestRedrawAt(IEClock::time_point Deadline);
+    void RequestRedrawIn(std::chrono::nanoseconds Delay) { RequestRedrawAt(IEClock::now() + Delay); }
+    // Redraws every frame until the duration elapses.
+    void RequestAnimationFor(std::chrono::nanoseconds Duration);
+    // Polls while animating, no sooner than the refresh decision's FrameDuration after the previous redraw, otherwise waits
+    // for events until the earliest redraw deadline, or indefinitely when none is pending.
+    // Returns true when it blocked. A couple of frames are always drawn after a wake so ImGui can settle layout and hover states.
+    bool WaitForNextRedraw();
+
+    /* Refresh Governor */
+    // Replaces the default IEAdaptiveRefreshGovernor, which decides the loop frame rate on every WaitForNextRedraw.
+    void SetRefreshGovernor(std::unique_ptr<IERefreshGovernor> Governor);
+    const IERefreshDecision& GetRefreshDecision() const { return m_RefreshDecision; }
+    // Thread safe activity hint for widgets and app code that change what is on screen without user input.
+    void NotifyUIActivity();
+    std::chrono::nanoseconds GetDisplayFrameDuration() const;
+
     bool IsAppRunning() const;
     bool IsAppWindowOpen() const;
     bool IsAppWindowMinimized() const;
+    bool IsAppWindowFocused() const { return m_bAppWindowFocused; }
     bool SupportsRunInBackground() const;
 
     void OnAppWindowCloseRequested();
@@ -62,7 +125,7 @@ public:
 
     void CloseAppWindow();
     void MinimizeAppWindow() const;
-    void RestoreAppWindow() const;
+    void RestoreAppWindow();
     void NotifyOSRunInBackground() const;
 
     void AddOnWindowCloseCallbackFunc(uint32_t WindowID, const IEWindowCallbackFunc& Func);
@@ -75,8 +138,50 @@ public:
     uint32_t GetAppWindowID() const;
     std::string GetIELogoPathString() const;
     void DrawTelemetry() const;
+    // Adds per stage p50/p95/p99/max and frame time plots below the frame duration line.
+    void SetDetailedTelemetryVisible(bool bVisible) { m_bDetailedTelemetryVisible = bVisible; }
+    bool IsDetailedTelemetryVisible() const { return m_bDetailedTelemetryVisible; }
+    // While closed to the background, swapchain, frame resources and the font texture are released and rebuilt on restore.
+    void SetBackgroundTrimEnabled(bool bEnabled) { m_bBackgroundTrimEnabled = bEnabled; }
+    bool IsBackgroundTrimEnabled() const { return m_bBackgroundTrimEnabled; }
+    const IEInputLayer& GetInputLayer() const { return m_InputLayer; }
+    // Records every input event of the session, see IEInputLayer::StartRecording.
+    IEResult StartInputRecording(const std::filesystem::path& Path = std::filesystem::path());
+    void StopInputRecording();
+    // Replays a recording with a fixed ImGui delta time, per frame stage timings go to <Path>.timings.csv and
+    // the frame time percentiles are logged once the replay finishes.
+    IEResult StartInputReplay(const std::filesystem::path& Path, std::chrono::nanoseconds FixedDeltaTime = std::chrono::microseconds(16667));
+    bool IsReplayingInput() const { return m_InputLayer.IsReplaying(); }
+    IEFrameProfiler& GetFrameProfiler() { return m_FrameProfiler; }
+    const IEFrameProfiler& GetFrameProfiler() const { return m_FrameProfiler; }
+    // RenderFrame and PresentFrame skip acquire/record/submit/present when the ImDrawData contents hash matches the last presented frame.
+    // Telemetry values are then refreshed twice per second so the overlay does not damage every frame on its own.
+    void SetDamageTrackingEnabled(bool bEnabled);
+    bool IsDamageTrackingEnabled() const { return m_bDamageTrackingEnabled; }
+    uint64_t GetRenderedFrameCount() const { return m_RenderedFrameCount; }
+    uint64_t GetSkippedFrameCount() const { return m_SkippedFrameCount; }
+
+protected:
+    virtual void ReleaseWindowResources() = 0;
+    // Returns false when the window resources are still released.
+    virtual bool RestoreWindowResources() = 0;
+    // Appended to the detailed telemetry.
+    virtual void DrawBackendTelemetry() const {}
+
+protected:
+    // Returns false when damage tracking is enabled and DrawData matches the last presented frame.
+    bool HasDrawDataChanged(const ImDrawData& DrawData);
+    void OnDrawDataPresented();
+    // Forces the next frame to render, e.g. after the swapchain images were recreated.
+    void InvalidatePresentedDrawData() { m_PresentedDrawDataHash.reset(); }
+    // Called by PresentFrame once the frame profiler committed the frame.
+    void OnFrameEnded();
 
 private:
+    void DrawFrameProfilerTelemetry() const;
+    static uint64_t ComputeDrawDataHash(const ImDrawData& DrawData);
+    void OnInputEvent(IEInputEvent Event);
+    void UpdateRefreshDecision(bool bAnimating);
     void InitializeOSApp();
     void BroadcastOnWindowClosed() const;
     void BroadcastOnWindowMinimized() const;
@@ -88,6 +193,11 @@ protected:
     int32_t m_DefaultAppWindowWidth = 1280;
     int32_t m_DefaultAppWindowHeight = 720;
     bool m_bAllowRunInBackground = false;
+    bool m_bBackgroundTrimEnabled = false;
+    IEFrameProfiler m_FrameProfiler;
+    IEInputLayer m_InputLayer;
+    std::chrono::nanoseconds m_ReplayDeltaTime{};
+    FILE* m_ReplayTimingsFile = nullptr;
 
 private:
     std::vector<std::pair<uint32_t, IEWindowCallbackFunc>> m_OnWindowCloseCallbackFunc;
@@ -96,6 +206,48 @@ private:
 
 private:
     bool m_ExitRequested = false; 
+    bool m_bDetailedTelemetryVisible = false;
+    bool m_bAppWindowIconified = false;
+    bool m_bAppWindowFocused = true;
+    bool m_bFrameAdmitted = true;
+
+private:
+    struct BackgroundTick
+    {
+        std::chrono::nanoseconds Interval;
+        IEClock::time_point NextTickTime;
+        IEBackgroundTickFunc Func;
+    };
+    std::vector<BackgroundTick> m_BackgroundTicks;
+
+private:
+    bool m_bDamageTrackingEnabled = false;
+    uint64_t m_PendingDrawDataHash = 0;
+    std::optional<uint64_t> m_PresentedDrawDataHash;
+    uint64_t m_RenderedFrameCount = 0;
+    uint64_t m_SkippedFrameCount = 0;
+
+    struct TelemetrySample
+    {
+        IEClock::time_point Time;
+        float Framerate = 0.0f;
+        uint64_t RenderedFrameCount = 0;
+        uint64_t SkippedFrameCount = 0;
+    };
+    mutable TelemetrySample m_TelemetrySample;
+
+private:
+    std::mutex m_RedrawScheduleMutex;
+    std::priority_queue<IEClock::time_point, std::vector<IEClock::time_point>, std::greater<IEClock::time_point>> m_RedrawDeadlines;
+    IEClock::time_point m_AnimateUntil;
+    uint32_t m_SettleFrameCount = 0;
+    IEClock::time_point m_LastRedrawTime;
+
+private:
+    std::unique_ptr<IERefreshGovernor> m_RefreshGovernor = std::make_unique<IEAdaptiveRefreshGovernor>();
+    IERefreshDecision m_RefreshDecision;
+    std::atomic<IEClock::rep> m_LastInputTicks = 0;
+    std::atomic<IEClock::rep> m_LastActivityHintTicks = 0;
 };
 
 class IERenderer_Vulkan : public IERenderer
@@ -111,6 +263,21 @@ public:
     void NewFrame() override;
     void RenderFrame(ImDrawData& DrawData) override;
     void PresentFrame() override;
+
+    void SetRenderThreadEnabled(bool bEnabled) override;
+    bool IsRenderThreadEnabled() const override { return m_bRenderThreadEnabled; }
+    void SetFramesInFlight(uint32_t Count) override;
+    uint32_t GetFramesInFlight() const override { return m_FramesInFlightCount; }
+    void SetLatencyMode(IELatencyMode LatencyMode) override;
+    IELatencyMode GetLatencyMode() const override { return m_LatencyMode; }
+    void SetHostAllocatorEnabled(bool bEnabled) override;
+    /* End IERenderer Implementation */
+
+protected:
+    /* Begin IERenderer Implementation */
+    void ReleaseWindowResources() override;
+    bool RestoreWindowResources() override;
+    void DrawBackendTelemetry() const override;
     /* End IERenderer Implementation */
 
 private:
@@ -119,12 +286,82 @@ private:
 
 private:
     IEResult InitializeVulkan();
-    IEResult InitializeInstancePhysicalDevice();
+    // Required extensions fail initialization when missing, optional ones are enabled only when available.
+    IEExpected<std::vector<const char*>> NegotiateInstanceExtensions() const;
+    IEExpected<VkInstance> CreateInstance() const;
+    // Picks the highest scored device, IE_VULKAN_DEVICE=<index or name substring> overrides the choice.
+    IEExpected<VkPhysicalDevice> SelectPhysicalDevice() const;
+    // Negative when the device cannot present from a graphics queue or lacks a required extension.
+    int64_t ScorePhysicalDevice(VkPhysicalDevice PhysicalDevice) const;
+    std::optional<uint32_t> FindGraphicsPresentQueueFamilyIndex(VkPhysicalDevice PhysicalDevice) const;
+    IEExpected<uint32_t> FindGraphicsQueueFamilyIndex() const;
+    IEExpected<std::vector<const char*>> NegotiateDeviceExtensions() const;
+    IEExpected<VkDevice> CreateDevice() const;
+    static std::vector<VkExtensionProperties> EnumerateDeviceExtensionProperties(VkPhysicalDevice PhysicalDevice);
+    static bool HasExtension(const std::vector<VkExtensionProperties>& ExtensionProperties, const char* ExtensionName);
+    bool IsInstanceExtensionEnabled(const char* ExtensionName) const;
+    bool IsDeviceExtensionEnabled(const char* ExtensionName) const;
+    IEExpected<VkDescriptorPool> CreateDescriptorPool() const;
+    IEExpected<VkSurfaceKHR> CreateWindowSurface() const;
     void DinitializeVulkan();
 
+    // Pipeline cache persisted in the IE config folder, returns true when a compatible cache was loaded.
+    std::filesystem::path GetPipelineCachePath() const;
+    bool CreatePipelineCache();
+    // Copies the cache out and writes it on a worker thread, skipped while its size matches the last save.
+    void SavePipelineCache();
+    void WaitForPipelineCacheSave();
+    static bool IsPipelineCacheDataCompatible(const std::vector<uint8_t>& Data, const VkPhysicalDeviceProperties& PhysicalDeviceProperties);
+
+    void SelectSurfaceFormatAndPresentMode();
+    // Resolves m_LatencyMode into the surface present mode and m_MinImageCount.
+    void SelectPresentMode();
+    // Sum of VK_EXT_memory_budget heap usage over device local heaps, 0 when the extension was not enabled.
+    uint64_t GetDeviceMemoryUsageBytes() const;
+
+    bool CreateFramesInFlight();
+    // Returns the slot to a usable state after a frame failed between acquiring its image and submitting.
+    void RecoverFrameInFlight(uint32_t FrameInFlightIndex, bool bFenceReset);
+    void DestroyFramesInFlight();
+    // Frees the per image command buffers, fences and image acquired semaphores ImGui creates with the swapchain, they are never used.
+    void ReleaseUnusedImGuiFrameResources();
+
+    void CreateTimestampQueryPool();
+    void DestroyTimestampQueryPool();
+    void WriteTimestampQuery(VkCommandBuffer CommandBuffer, uint32_t FrameIndex, VkPipelineStageFlagBits PipelineStage);
+    void CollectTimestampQueries(uint32_t FrameIndex);
+
+    // Fence wait, acquire, record and submit, returns false when nothing was submitted.
+    bool RecordAndSubmitFrame(ImDrawData& DrawData);
+    // Returns true once the frame was handed to the presentation engine.
+    bool PresentSubmittedFrame();
+
+    void StartRenderThread();
+    void StopRenderThread();
+    // Blocks until the render thread has no frame queued or in flight, required before touching the swapchain or the queue.
+    void WaitForRenderThreadIdle();
+    void QueueDrawDataSnapshot(const ImDrawData& DrawData);
+    void RenderThreadLoop();
+
+private:
+    static constexpr uint32_t MaxFramesInFlight = 3;
+
+    // Per frame resources, the framebuffers and render complete semaphores stay per swapchain image in m_AppWindowVulkanData
+    struct FrameInFlight
+    {
+        VkCommandPool CommandPool = VK_NULL_HANDLE;
+        VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+        VkFence Fence = VK_NULL_HANDLE;
+        VkSemaphore ImageAcquiredSemaphore = VK_NULL_HANDLE;
+    };
+
 private:
     ImGui_ImplVulkanH_Window m_AppWindowVulkanData = {};
+    bool m_bImGuiBackendsInitialized = false;
 
+    // Declared before the Vulkan handles, it must outlive every object allocated through it
+    IEVulkanHostAllocator m_HostAllocator;
+    bool m_bHostAllocatorEnabled = false;
     VkAllocationCallbacks* m_VkAllocationCallback = nullptr;
     VkInstance m_VkInstance = nullptr;
     VkPhysicalDevice m_VkPhysicalDevice = nullptr;
@@ -132,9 +369,38 @@ private:
     VkQueue m_VkQueue = nullptr;
     VkDebugReportCallbackEXT m_VkDebugReportCallbackEXT = nullptr;
     VkPipelineCache m_VkPipelineCache = nullptr;
+    size_t m_SavedPipelineCacheSize = 0;
+    std::future<void> m_PipelineCacheSaveTask;
     VkDescriptorPool m_VkDescriptorPool = nullptr;
+    std::vector<const char*> m_EnabledInstanceExtensionNames;
+    std::vector<const char*> m_EnabledDeviceExtensionNames;
 
     uint32_t m_QueueFamilyIndex = static_cast<uint32_t>(-1);
     int m_MinImageCount = 2;
-    bool m_SwapChainRebuild = false;
+    IELatencyMode m_LatencyMode = IELatencyMode::PowerSaving;
+    bool m_bPresentModeChanged = false;
+    std::atomic<bool> m_SwapChainRebuild = false;
+    bool m_bFrameSubmitted = false;
+    bool m_bWindowResourcesReleased = false;
+
+    VkQueryPool m_VkTimestampQueryPool = VK_NULL_HANDLE;
+    std::vector<bool> m_TimestampQueryWritten;
+    uint64_t m_TimestampValidMask = 0;
+    float m_TimestampPeriodNs = 0.0f;
+
+    std::array<FrameInFlight, MaxFramesInFlight> m_FramesInFlight = {};
+    uint32_t m_FramesInFlightCount = 2;
+    uint32_t m_FrameInFlightIndex = 0;
+
+    bool m_bRenderThreadEnabled = false;
+    std::thread m_RenderThread;
+    std::mutex m_RenderThreadMutex;
+    std::condition_variable m_RenderThreadCondition;
+    // One snapshot is rendered while the UI thread fills the other
+    std::array<IEDrawDataSnapshot, 2> m_DrawDataSnapshots;
+    int32_t m_QueuedSnapshotIndex = -1;
+    int32_t m_RenderingSnapshotIndex = -1;
+    bool m_bRenderThreadExitRequested = false;
+    // Set by the render thread when a snapshot the UI thread counted as presented never reached the screen
+    std::atomic<bool> m_bSnapshotDropped = false;
 };
\ No newline at end of file
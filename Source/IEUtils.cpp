@@ -4,6 +4,12 @@
 
 #include "IEUtils.h"
 
+#if defined (_WIN32)
+#include <psapi.h>
+#elif defined (__APPLE__)
+#include <mach/mach.h>
+#endif
+
 #ifndef IERESOURCES_DIR
 #error "IERESOURCES_DIR is not defined!"
 #endif
@@ -124,4 +130,34 @@ namespace IEUtils
         }
         return bIsHidden;
     }
-}
\ No newline at end of file
+
+    uint64_t GetResidentMemoryBytes()
+    {
+        uint64_t ResidentMemoryBytes = 0;
+#if defined (_WIN32)
+        PROCESS_MEMORY_COUNTERS MemoryCounters = {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &MemoryCounters, sizeof(MemoryCounters)))
+        {
+            ResidentMemoryBytes = MemoryCounters.WorkingSetSize;
+        }
+#elif defined (__APPLE__)
+        mach_task_basic_info_data_t TaskInfo = {};
+        mach_msg_type_number_t TaskInfoCount = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&TaskInfo), &TaskInfoCount) == KERN_SUCCESS)
+        {
+            ResidentMemoryBytes = TaskInfo.resident_size;
+        }
+#elif defined (__linux__)
+        if (FILE* const StatmFile = std::fopen("/proc/self/statm", "r"))
+        {
+            unsigned long long TotalPages = 0, ResidentPages = 0;
+            if (std::fscanf(StatmFile, "%llu %llu", &TotalPages, &ResidentPages) == 2)
+            {
+                ResidentMemoryBytes = ResidentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            }
+            std::fclose(StatmFile);
+        }
+#endif
+        return ResidentMemoryBytes;
+    }
+}
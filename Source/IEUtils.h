@@ -140,4 +140,9 @@ namespace IEUtils
     std::filesystem::path GetIEConfigFolderPath();
     std::filesystem::path GetIEResourceFolderPath();
     bool IsFileHidden(const std::filesystem::path& Path);
+
+    /* Process */
+
+    // Resident set size of the current process, 0 when the platform query fails.
+    uint64_t GetResidentMemoryBytes();
 }
\ No newline at end of file
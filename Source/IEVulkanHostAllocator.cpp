@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IEVulkanHostAllocator.h"
+
+IEVulkanHostAllocator::IEVulkanHostAllocator()
+{
+    m_AllocationCallbacks.pUserData = this;
+    m_AllocationCallbacks.pfnAllocation = &IEVulkanHostAllocator::AllocationFunc;
+    m_AllocationCallbacks.pfnReallocation = &IEVulkanHostAllocator::ReallocationFunc;
+    m_AllocationCallbacks.pfnFree = &IEVulkanHostAllocator::FreeFunc;
+    m_AllocationCallbacks.pfnInternalAllocation = &IEVulkanHostAllocator::InternalAllocationFunc;
+    m_AllocationCallbacks.pfnInternalFree = &IEVulkanHostAllocator::InternalFreeFunc;
+}
+
+IEVulkanHostAllocator::~IEVulkanHostAllocator()
+{
+    Trim();
+    for (uint32_t ScopeIndex = 0; ScopeIndex < ScopeCount; ScopeIndex++)
+    {
+        const ScopePool& Pool = m_ScopePools[ScopeIndex];
+        const uint64_t LiveAllocationCount = Pool.LiveAllocationCount.load(std::memory_order_relaxed);
+        if (LiveAllocationCount > 0)
+        {
+            IELOG_CATEGORY_WARNING(Renderer, "Vulkan leaked %llu host allocations (%llu bytes) in scope %s", static_cast<unsigned long long>(LiveAllocationCount),
+                static_cast<unsigned long long>(Pool.LiveBytes.load(std::memory_order_relaxed)), GetScopeName(static_cast<VkSystemAllocationScope>(ScopeIndex)));
+        }
+    }
+}
+
+IEVulkanHostAllocator::ScopeStatistics IEVulkanHostAllocator::GetScopeStatistics(VkSystemAllocationScope Scope) const
+{
+    ScopeStatistics Statistics;
+    if (static_cast<uint32_t>(Scope) < ScopeCount)
+    {
+        const ScopePool& Pool = m_ScopePools[Scope];
+        Statistics.LiveBytes = Pool.LiveBytes.load(std::memory_order_relaxed);
+        Statistics.PeakBytes = Pool.PeakBytes.load(std::memory_order_relaxed);
+        Statistics.LiveAllocationCount = Pool.LiveAllocationCount.load(std::memory_order_relaxed);
+        Statistics.PooledAllocationCount = Pool.PooledAllocationCount.load(std::memory_order_relaxed);
+        Statistics.SystemAllocationCount = Pool.SystemAllocationCount.load(std::memory_order_relaxed);
+        Statistics.InternalBytes = Pool.InternalBytes.load(std::memory_order_relaxed);
+        Statistics.CachedBytes = Pool.CachedBytes.load(std::memory_order_relaxed);
+    }
+    return Statistics;
+}
+
+uint64_t IEVulkanHostAllocator::Trim()
+{
+    uint64_t ReleasedBytes = 0;
+    for (ScopePool& Pool : m_ScopePools)
+    {
+        std::array<void*, SizeClassCount> FreeBlocks = {};
+        {
+            std::lock_guard<std::mutex> Lock(Pool.Mutex);
+            std::swap(FreeBlocks, Pool.FreeBlocks);
+        }
+
+        for (uint32_t SizeClass = 0; SizeClass < SizeClassCount; SizeClass++)
+        {
+            void* Block = FreeBlocks[SizeClass];
+            while (Block)
+            {
+                void* const NextBlock = *static_cast<void**>(Block);
+                ::operator delete(Block, std::align_val_t(PooledBlockAlignment));
+                Pool.CachedBytes.fetch_sub(MinBlockSize << SizeClass, std::memory_order_relaxed);
+                ReleasedBytes += MinBlockSize << SizeClass;
+                Block = NextBlock;
+            }
+        }
+    }
+    return ReleasedBytes;
+}
+
+const char* IEVulkanHostAllocator::GetScopeName(VkSystemAllocationScope Scope)
+{
+    switch (Scope)
+    {
+    case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "Command";
+    case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "Object";
+    case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "Cache";
+    case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "Device";
+    case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "Instance";
+    default: return "Unknown";
+    }
+}
+
+void* IEVulkanHostAllocator::Allocate(size_t Size, size_t Alignment, VkSystemAllocationScope Scope)
+{
+    if (Size == 0)
+    {
+        return nullptr;
+    }
+
+    const uint32_t ScopeIndex = static_cast<uint32_t>(Scope) < ScopeCount ? static_cast<uint32_t>(Scope) : static_cast<uint32_t>(VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+    ScopePool& Pool = m_ScopePools[ScopeIndex];
+
+    Alignment = std::max(Alignment, alignof(BlockHeader));
+    const size_t Offset = GetHeaderOffset(Alignment);
+    const size_t RequiredSize = Offset + Size;
+
+    uint8_t* Block = nullptr;
+    uint16_t SizeClass = SizeClassCount;
+    size_t BlockAlignment = Alignment;
+    if (Alignment <= PooledBlockAlignment && RequiredSize <= MaxPooledBlockSize)
+    {
+        // Smallest class whose block size MinBlockSize << SizeClass fits the request
+        SizeClass = static_cast<uint16_t>(std::bit_width((RequiredSize - 1) / MinBlockSize));
+        BlockAlignment = PooledBlockAlignment;
+        {
+            std::lock_guard<std::mutex> Lock(Pool.Mutex);
+            Block = static_cast<uint8_t*>(Pool.FreeBlocks[SizeClass]);
+            if (Block)
+            {
+                Pool.FreeBlocks[SizeClass] = *reinterpret_cast<void**>(Block);
+            }
+        }
+        if (Block)
+        {
+            Pool.CachedBytes.fetch_sub(MinBlockSize << SizeClass, std::memory_order_relaxed);
+            Pool.PooledAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (!Block)
+    {
+        const size_t BlockSize = SizeClass < SizeClassCount ? MinBlockSize << SizeClass : RequiredSize;
+        Block = static_cast<uint8_t*>(::operator new(BlockSize, std::align_val_t(BlockAlignment), std::nothrow));
+        if (!Block)
+        {
+            return nullptr;
+        }
+        Pool.SystemAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint8_t* const Memory = Block + Offset;
+    BlockHeader* const Header = GetBlockHeader(Memory);
+    Header->Offset = static_cast<uint32_t>(Offset);
+    Header->SizeClass = SizeClass;
+    Header->Scope = static_cast<uint16_t>(ScopeIndex);
+    Header->Size = Size;
+    Header->BlockAlignment = BlockAlignment;
+
+    const uint64_t LiveBytes = Pool.LiveBytes.fetch_add(Size, std::memory_order_relaxed) + Size;
+    uint64_t PeakBytes = Pool.PeakBytes.load(std::memory_order_relaxed);
+    while (LiveBytes > PeakBytes && !Pool.PeakBytes.compare_exchange_weak(PeakBytes, LiveBytes, std::memory_order_relaxed)) {}
+    Pool.LiveAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return Memory;
+}
+
+void* IEVulkanHostAllocator::Reallocate(void* Original, size_t Size, size_t Alignment, VkSystemAllocationScope Scope)
+{
+    if (!Original)
+    {
+        return Allocate(Size, Alignment, Scope);
+    }
+    if (Size == 0)
+    {
+        Free(Original);
+        return nullptr;
+    }
+
+    BlockHeader* const Header = GetBlockHeader(Original);
+    if (Header->SizeClass < SizeClassCount && Header->Scope == static_cast<uint16_t>(Scope) && Header->Offset + Size <= (MinBlockSize << Header->SizeClass))
+    {
+        // Still fits the pooled block
+        ScopePool& Pool = m_ScopePools[Header->Scope];
+        if (Size > Header->Size)
+        {
+            const uint64_t LiveBytes = Pool.LiveBytes.fetch_add(Size - Header->Size, std::memory_order_relaxed) + (Size - Header->Size);
+            uint64_t PeakBytes = Pool.PeakBytes.load(std::memory_order_relaxed);
+            while (LiveBytes > PeakBytes && !Pool.PeakBytes.compare_exchange_weak(PeakBytes, LiveBytes, std::memory_order_relaxed)) {}
+        }
+        else
+        {
+            Pool.LiveBytes.fetch_sub(Header->Size - Size, std::memory_order_relaxed);
+        }
+        Header->Size = Size;
+        return Original;
+    }
+
+    void* const Memory = Allocate(Size, Alignment, Scope);
+    if (Memory)
+    {
+        std::memcpy(Memory, Original, std::min(Size, Header->Size));
+        Free(Original);
+    }
+    return Memory;
+}
+
+void IEVulkanHostAllocator::Free(void* Memory)
+{
+    if (Memory)
+    {
+        const BlockHeader Header = *GetBlockHeader(Memory);
+        ScopePool& Pool = m_ScopePools[Header.Scope];
+        Pool.LiveBytes.fetch_sub(Header.Size, std::memory_order_relaxed);
+        Pool.LiveAllocationCount.fetch_sub(1, std::memory_order_relaxed);
+
+        uint8_t* const Block = static_cast<uint8_t*>(Memory) - Header.Offset;
+        if (Header.SizeClass < SizeClassCount)
+        {
+            // The free list link overwrites the start of the block, the header was copied out above
+            Pool.CachedBytes.fetch_add(MinBlockSize << Header.SizeClass, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> Lock(Pool.Mutex);
+            *reinterpret_cast<void**>(Block) = Pool.FreeBlocks[Header.SizeClass];
+            Pool.FreeBlocks[Header.SizeClass] = Block;
+        }
+        else
+        {
+            ::operator delete(Block, std::align_val_t(Header.BlockAlignment));
+        }
+    }
+}
+
+size_t IEVulkanHostAllocator::GetHeaderOffset(size_t Alignment)
+{
+    // Vulkan alignments are powers of two, the user pointer stays aligned and the header sits right before it
+    return (sizeof(BlockHeader) + Alignment - 1) & ~(Alignment - 1);
+}
+
+VKAPI_ATTR void* VKAPI_CALL IEVulkanHostAllocator::AllocationFunc(void* UserData, size_t Size, size_t Alignment, VkSystemAllocationScope Scope)
+{
+    return static_cast<IEVulkanHostAllocator*>(UserData)->Allocate(Size, Alignment, Scope);
+}
+
+VKAPI_ATTR void* VKAPI_CALL IEVulkanHostAllocator::ReallocationFunc(void* UserData, void* Original, size_t Size, size_t Alignment, VkSystemAllocationScope Scope)
+{
+    return static_cast<IEVulkanHostAllocator*>(UserData)->Reallocate(Original, Size, Alignment, Scope);
+}
+
+VKAPI_ATTR void VKAPI_CALL IEVulkanHostAllocator::FreeFunc(void* UserData, void* Memory)
+{
+    static_cast<IEVulkanHostAllocator*>(UserData)->Free(Memory);
+}
+
+VKAPI_ATTR void VKAPI_CALL IEVulkanHostAllocator::InternalAllocationFunc(void* UserData, size_t Size, [[maybe_unused]] VkInternalAllocationType Type, VkSystemAllocationScope Scope)
+{
+    if (static_cast<uint32_t>(Scope) < ScopeCount)
+    {
+        static_cast<IEVulkanHostAllocator*>(UserData)->m_ScopePools[Scope].InternalBytes.fetch_add(Size, std::memory_order_relaxed);
+    }
+}
+
+VKAPI_ATTR void VKAPI_CALL IEVulkanHostAllocator::InternalFreeFunc(void* UserData, size_t Size, [[maybe_unused]] VkInternalAllocationType Type, VkSystemAllocationScope Scope)
+{
+    if (static_cast<uint32_t>(Scope) < ScopeCount)
+    {
+        static_cast<IEVulkanHostAllocator*>(UserData)->m_ScopePools[Scope].InternalBytes.fetch_sub(Size, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "IECommon.h"
+
+// VkAllocationCallbacks routing the driver's host allocations into power of two size class pools, one set per allocation scope.
+// Freed blocks go back to their pool instead of the system allocator, so the churn of swapchain rebuilds and per frame
+// command allocations is served from recycled blocks. Live and peak bytes are tracked per scope to spot leaks in long sessions.
+// Callbacks are thread safe, the driver may call them from any thread. Must outlive every Vulkan object created with it.
+class IEVulkanHostAllocator
+{
+public:
+    static constexpr uint32_t ScopeCount = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+    static constexpr uint32_t SizeClassCount = 9;               // 64 bytes to 16 KiB blocks
+    static constexpr size_t MinBlockSize = 64;
+    static constexpr size_t MaxPooledBlockSize = MinBlockSize << (SizeClassCount - 1);
+    static constexpr size_t PooledBlockAlignment = 64;          // Larger alignment requests bypass the pools
+
+    struct ScopeStatistics
+    {
+        uint64_t LiveBytes = 0;
+        uint64_t PeakBytes = 0;
+        uint64_t LiveAllocationCount = 0;
+        uint64_t PooledAllocationCount = 0;     // Served from a recycled block
+        uint64_t SystemAllocationCount = 0;     // Had to call into the system allocator
+        uint64_t InternalBytes = 0;             // Reported by the driver through the internal allocation notifications
+        uint64_t CachedBytes = 0;               // Freed blocks held in the pools, not counted in LiveBytes
+    };
+
+public:
+    IEVulkanHostAllocator();
+    ~IEVulkanHostAllocator();
+
+    IEVulkanHostAllocator(const IEVulkanHostAllocator&) = delete;
+    IEVulkanHostAllocator& operator=(const IEVulkanHostAllocator&) = delete;
+
+public:
+    VkAllocationCallbacks* GetAllocationCallbacks() { return &m_AllocationCallbacks; }
+    ScopeStatistics GetScopeStatistics(VkSystemAllocationScope Scope) const;
+    // Returns every pooled free block to the system, e.g. when the app goes to the background. Returns the bytes released.
+    uint64_t Trim();
+    static const char* GetScopeName(VkSystemAllocationScope Scope);
+
+private:
+    // Stored right before every returned pointer
+    struct BlockHeader
+    {
+        uint32_t Offset;        // From the block start to the user pointer
+        uint16_t SizeClass;     // SizeClassCount for system blocks
+        uint16_t Scope;
+        size_t Size;            // Requested size
+        size_t BlockAlignment;  // System blocks only
+    };
+
+    struct ScopePool
+    {
+        std::mutex Mutex;
+        std::array<void*, SizeClassCount> FreeBlocks = {};
+        std::atomic<uint64_t> LiveBytes = 0;
+        std::atomic<uint64_t> PeakBytes = 0;
+        std::atomic<uint64_t> LiveAllocationCount = 0;
+        std::atomic<uint64_t> PooledAllocationCount = 0;
+        std::atomic<uint64_t> SystemAllocationCount = 0;
+        std::atomic<uint64_t> InternalBytes = 0;
+        std::atomic<uint64_t> CachedBytes = 0;
+    };
+
+private:
+    void* Allocate(size_t Size, size_t Alignment, VkSystemAllocationScope Scope);
+    void* Reallocate(void* Original, size_t Size, size_t Alignment, VkSystemAllocationScope Scope);
+    void Free(void* Memory);
+    static BlockHeader* GetBlockHeader(void* Memory) { return reinterpret_cast<BlockHeader*>(static_cast<uint8_t*>(Memory) - sizeof(BlockHeader)); }
+    static size_t GetHeaderOffset(size_t Alignment);
+
+    static VKAPI_ATTR void* VKAPI_CALL AllocationFunc(void* UserData, size_t Size, size_t Alignment, VkSystemAllocationScope Scope);
+    static VKAPI_ATTR void* VKAPI_CALL ReallocationFunc(void* UserData, void* Original, size_t Size, size_t Alignment, VkSystemAllocationScope Scope);
+    static VKAPI_ATTR void VKAPI_CALL FreeFunc(void* UserData, void* Memory);
+    static VKAPI_ATTR void VKAPI_CALL InternalAllocationFunc(void* UserData, size_t Size, VkInternalAllocationType Type, VkSystemAllocationScope Scope);
+    static VKAPI_ATTR void VKAPI_CALL InternalFreeFunc(void* UserData, size_t Size, VkInternalAllocationType Type, VkSystemAllocationScope Scope);
+
+private:
+    VkAllocationCallbacks m_AllocationCallbacks = {};
+    std::array<ScopePool, ScopeCount> m_ScopePools;
+};
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: GPL-2.0-only
+// Copyright © Interactive Echoes. All rights reserved.
+// Author: mozahzah
+
+#include "IECore.h"
+
+// Usage: IELogDecoder <binary log> [output text file]
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s <binary log> [output text file]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* Output = stdout;
+    if (argc >= 3)
+    {
+        Output = std::fopen(argv[2], "w");
+        if (!Output)
+        {
+            std::fprintf(stderr, "Failed to open %s for writing\n", argv[2]);
+            return 1;
+        }
+    }
+
+    const IEResult Result = IELogger::DecodeBinaryLog(std::filesystem::path(argv[1]), Output);
+    if (Output != stdout)
+    {
+        std::fclose(Output);
+    }
+
+    if (Result.Type != IEResult::Type::Success)
+    {
+        std::fprintf(stderr, "%s\n", Result.Message.ToString().c_str());
+        return 1;
+    }
+    return 0;
+}